@@ -0,0 +1,237 @@
+#include "batch.hpp"
+#include "graph.hpp"
+#include "graph_reader.hpp"
+#include "compressed_graph.hpp"
+#include "tarjan.hpp"
+#include "eulerian.hpp"
+#include "scheduler.hpp"
+#include "trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <glob.h>
+
+
+namespace batch {
+
+    //---- Métodos auxiliares ----//
+
+    long __micros(std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+    }
+
+    /// @brief Half of MemAvailable, 1GB when /proc/meminfo is missing
+    uint64_t __defaultBudget() {
+        std::ifstream meminfo("/proc/meminfo");
+        std::string key;
+        uint64_t kilobytes;
+        while (meminfo >> key >> kilobytes) {
+            if (key == "MemAvailable:") return kilobytes * 1024 / 2;
+            meminfo.ignore(256, '\n');
+        }
+        return uint64_t(1) << 30;
+    }
+
+    bool __hasWildcard(const std::string& spec) {
+        return spec.find_first_of("*?[") != std::string::npos;
+    }
+
+    Response<std::vector<std::string>> __expandGlob(const std::string& pattern) {
+        glob_t matches;
+        int status = ::glob(pattern.c_str(), 0, nullptr, &matches);
+        if (status == GLOB_NOMATCH) return Response<std::vector<std::string>>(std::vector<std::string>());
+        if (status != 0) return Response<std::vector<std::string>>(ErrorCode::READ_FAILED, "Error: Could not expand " + pattern);
+
+        std::vector<std::string> files(matches.gl_pathv, matches.gl_pathv + matches.gl_pathc);
+        ::globfree(&matches);
+        return Response<std::vector<std::string>>(std::move(files));
+    }
+
+    Response<std::vector<std::string>> __readManifest(const std::string& manifest) {
+        std::ifstream in(manifest);
+        if (!in) return Response<std::vector<std::string>>(ErrorCode::OPEN_FAILED, "Error: Could not open manifest " + manifest);
+
+        const std::filesystem::path base = std::filesystem::path(manifest).parent_path();
+        std::vector<std::string> files;
+        std::string line;
+        while (std::getline(in, line)) {
+            line.erase(0, line.find_first_not_of(" \t"));
+            line.erase(line.find_last_not_of(" \t\r") + 1);
+            if (line.empty() || line[0] == '#') continue;
+
+            std::filesystem::path path(line);
+            files.push_back(path.is_absolute() ? line : (base / path).string());
+        }
+        return Response<std::vector<std::string>>(std::move(files));
+    }
+
+    BatchResult __process(const std::string& file, const BatchOptions& options, int worker) {
+        thread_local std::vector<char> ioBuffer(64 * 1024);
+
+        BatchResult result;
+        result.file = file;
+        result.worker = worker;
+
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        Response<Graph> read = graphformat::readGraphFromFile(file, ioBuffer);
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        result.readMicros = __micros(begin, end);
+        if (!read.isOk()) {
+            result.code = read.code;
+            result.message = read.describe();
+            return result;
+        }
+
+        Graph& graph = read.value;
+        result.vertices = graph.getVertexQuantity();
+        result.edges = graph.getTotalQuantityEdges();
+
+        begin = std::chrono::steady_clock::now();
+        result.bridges = tarjanAllComponents(graph).size();
+        end = std::chrono::steady_clock::now();
+        result.bridgesMicros = __micros(begin, end);
+
+        if (options.eulerianPath) {
+            begin = std::chrono::steady_clock::now();
+            result.pathLength = findEulerianPathHierholzer(CompressedGraph::compress(graph)).size();
+            end = std::chrono::steady_clock::now();
+            result.eulerMicros = __micros(begin, end);
+        }
+        return result;
+    }
+
+    std::string __csvField(const std::string& text) {
+        if (text.find_first_of(",\"\n") == std::string::npos) return text;
+
+        std::string quoted = "\"";
+        for (char c : text) {
+            if (c == '"') quoted += '"';
+            quoted += c;
+        }
+        return quoted + "\"";
+    }
+
+
+    //---- Métodos públicos ----//
+
+    Response<std::vector<std::string>> collectFiles(const std::string& spec) {
+        std::error_code error;
+        if (std::filesystem::is_directory(spec, error)) {
+            std::vector<std::string> files;
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(spec, error)) {
+                if (entry.is_regular_file() && entry.path().extension() == ".graph") files.push_back(entry.path().string());
+            }
+            if (error) return Response<std::vector<std::string>>(ErrorCode::READ_FAILED, "Error: Could not list " + spec);
+            std::sort(files.begin(), files.end());
+            return Response<std::vector<std::string>>(std::move(files));
+        }
+
+        if (__hasWildcard(spec)) return __expandGlob(spec);
+        if (std::filesystem::path(spec).extension() == ".graph") return Response<std::vector<std::string>>(std::vector<std::string>{spec});
+        return __readManifest(spec);
+    }
+
+    BatchSummary runBatch(const std::vector<std::string>& files, const BatchOptions& options) {
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+        BatchSummary summary;
+        summary.results.resize(files.size());
+        summary.memoryBudget = options.memoryBudget > 0 ? options.memoryBudget : __defaultBudget();
+
+        // Pending jobs by estimate, the largest one that fits is admitted next
+        std::multimap<uint64_t, size_t> pending;
+        for (size_t i = 0; i < files.size(); i++) {
+            std::error_code error;
+            uintmax_t bytes = std::filesystem::file_size(files[i], error);
+            uint64_t estimate = error ? 0 : static_cast<uint64_t>(bytes * options.memoryFactor);
+            pending.emplace(estimate, i);
+        }
+
+        sched::WorkStealingPool *pool = sched::sharedPool();
+        const size_t stealsBefore = pool != nullptr ? pool->stealCount() : 0;
+        const size_t inFlightLimit = 2 * static_cast<size_t>(sched::threadCount());  // Keeps admission decisions close to the actual load
+
+        std::mutex mutex;
+        std::condition_variable released;
+        uint64_t admitted = 0;
+        size_t running = 0;
+        sched::TaskGroup group;
+
+        std::multimap<uint64_t, size_t>::iterator job;
+        auto admissible = [&]() {
+            if (running >= inFlightLimit) return false;
+            if (running == 0) {
+                job = std::prev(pending.end());  // Even when over the budget, alone
+                return true;
+            }
+            uint64_t available = admitted < summary.memoryBudget ? summary.memoryBudget - admitted : 0;
+            auto fitting = pending.upper_bound(available);
+            if (fitting == pending.begin()) return false;
+            job = std::prev(fitting);
+            return true;
+        };
+
+        while (!pending.empty()) {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (!admissible()) {
+                // The dispatcher is one of the scheduler threads, it runs queued jobs while nothing fits
+                lock.unlock();
+                if (pool != nullptr && pool->runPending()) continue;
+                lock.lock();
+                released.wait(lock, admissible);
+            }
+
+            const uint64_t estimate = job->first;
+            const size_t index = job->second;
+            pending.erase(job);
+            admitted += estimate;
+            running++;
+            summary.peakAdmitted = std::max(summary.peakAdmitted, admitted);
+            lock.unlock();
+
+            group.run([&, estimate, index]() {
+                TRACE_SPAN("batch.job");
+                summary.results[index] = __process(files[index], options, sched::workerIndex());
+
+                std::lock_guard<std::mutex> guard(mutex);
+                admitted -= estimate;
+                running--;
+                released.notify_one();
+            });
+        }
+        group.wait();
+
+        for (const BatchResult& result : summary.results) {
+            if (result.code != ErrorCode::NONE) summary.failed++;
+        }
+        summary.steals = pool != nullptr ? pool->stealCount() - stealsBefore : 0;
+        summary.wallMillis = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin).count();
+        return summary;
+    }
+
+    Response<void> writeResults(const BatchSummary& summary, const std::string& filename) {
+        std::ofstream out(filename, std::ios::trunc);
+        if (!out) return Response<void>(ErrorCode::OPEN_FAILED, "Error: Could not open batch result file for writing");
+
+        out << "file,status,vertices,edges,bridges,eulerian_path_length,read_us,bridges_us,euler_us,worker" << std::endl;
+        for (const BatchResult& result : summary.results) {
+            out << __csvField(result.file) << ","
+                << (result.code == ErrorCode::NONE ? "ok" : __csvField(result.message)) << ","
+                << result.vertices << "," << result.edges << "," << result.bridges << "," << result.pathLength << ","
+                << result.readMicros << "," << result.bridgesMicros << "," << result.eulerMicros << "," << result.worker << std::endl;
+        }
+        out << "# files " << summary.results.size() << ", failed " << summary.failed << ", wall " << summary.wallMillis
+            << "ms, steals " << summary.steals << ", budget " << summary.memoryBudget << " bytes, peak admitted "
+            << summary.peakAdmitted << " bytes" << std::endl;
+
+        out.close();
+        if (!out) return Response<void>(ErrorCode::WRITE_FAILED, "Error: Could not write batch result file");
+        return Response<void>();
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef BATCH_HPP
+#define BATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "response_struct.hpp"
+
+
+/**
+ * @brief Runs load + bridges + Eulerian path over many .graph files at once
+ *
+ * Every file is a job on the shared work-stealing scheduler (sched::threadCount() threads). Jobs are admitted largest first, as long
+ * as the memory estimated for the admitted jobs stays within a budget: a big graph waits
+ * for room while smaller ones that still fit keep the other cores busy. A job larger than
+ * the whole budget runs alone.
+ *
+ * The estimate is the file size times `memoryFactor`, which covers the adjacency lists,
+ * the compressed copy used by Hierholzer and the DFS arrays of Tarjan.
+ */
+namespace batch {
+
+    struct BatchOptions {
+        uint64_t memoryBudget = 0;   // Bytes, 0 uses half of the available memory
+        double memoryFactor = 4.0;   // Estimated resident bytes per .graph byte
+        bool eulerianPath = true;    // Also runs Hierholzer on each graph
+    };
+
+    struct BatchResult {
+        std::string file;
+        ErrorCode code = ErrorCode::NONE;
+        std::string message;      // Filled only on errors
+        int vertices = 0;
+        int edges = 0;
+        size_t bridges = 0;
+        size_t pathLength = 0;    // 0 when the graph has no Eulerian path
+        long readMicros = 0;
+        long bridgesMicros = 0;
+        long eulerMicros = 0;
+        int worker = 0;           // sched::workerIndex() of the thread that ran it
+    };
+
+    struct BatchSummary {
+        std::vector<BatchResult> results;  // Input order
+        long wallMillis = 0;
+        size_t failed = 0;
+        size_t steals = 0;                 // Tasks taken from another worker's deque meanwhile
+        uint64_t memoryBudget = 0;
+        uint64_t peakAdmitted = 0;         // Largest estimate admitted at once
+    };
+
+    /**
+     * @brief Files named by `spec`
+     *
+     * - a folder: every .graph file under it, recursively
+     * - a glob pattern, wildcards (* ? [...]) may appear on any component
+     * - a .graph file
+     * - anything else is a manifest: one path per line, '#' comments, relative paths
+     *   resolved from the manifest folder
+     *
+     * Folders and globs come out in name order.
+     */
+    Response<std::vector<std::string>> collectFiles(const std::string& spec);
+
+    BatchSummary runBatch(const std::vector<std::string>& files, const BatchOptions& options = BatchOptions());
+
+    /// @brief One CSV line per file, followed by a '#' summary line
+    Response<void> writeResults(const BatchSummary& summary, const std::string& filename);
+}
+
+
+#endif  // BATCH_HPP
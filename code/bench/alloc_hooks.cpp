@@ -0,0 +1,91 @@
+#include "alloc_tracker.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+
+/*
+ * Replacement of the global operator new/delete feeding alloctracker.
+ *
+ * Every block carries a header with its requested size, so frees are accounted for even
+ * when the unsized delete is called. The header is as large as the alignment of the block
+ * (max_align_t for plain new), which keeps the returned pointer aligned.
+ */
+namespace {
+
+    const size_t DEFAULT_ALIGNMENT = alignof(std::max_align_t);
+
+    struct HookRegistration {
+        HookRegistration() { alloctracker::markHooked(); }
+    } registration;
+
+    void* allocate(size_t size, size_t alignment) {
+        if (alignment < DEFAULT_ALIGNMENT) alignment = DEFAULT_ALIGNMENT;
+
+        void *raw = nullptr;
+        if (alignment == DEFAULT_ALIGNMENT) {
+            raw = std::malloc(size + alignment);
+        } else {
+            // aligned_alloc wants a multiple of the alignment
+            size_t total = (size + alignment + alignment - 1) / alignment * alignment;
+            raw = std::aligned_alloc(alignment, total);
+        }
+        if (raw == nullptr) return nullptr;
+
+        char *block = static_cast<char*>(raw) + alignment;
+        reinterpret_cast<size_t*>(block)[-1] = size;
+        reinterpret_cast<size_t*>(block)[-2] = alignment;
+        alloctracker::recordAllocation(size);
+        return block;
+    }
+
+    void release(void *pointer) {
+        if (pointer == nullptr) return;
+
+        size_t size = static_cast<size_t*>(pointer)[-1];
+        size_t alignment = static_cast<size_t*>(pointer)[-2];
+        alloctracker::recordFree(size);
+        std::free(static_cast<char*>(pointer) - alignment);
+    }
+
+    void* allocateOrThrow(size_t size, size_t alignment) {
+        if (size == 0) size = 1;
+        for (;;) {
+            void *block = allocate(size, alignment);
+            if (block != nullptr) return block;
+
+            std::new_handler handler = std::get_new_handler();
+            if (handler == nullptr) throw std::bad_alloc();
+            handler();
+        }
+    }
+}
+
+
+void* operator new(size_t size) { return allocateOrThrow(size, DEFAULT_ALIGNMENT); }
+void* operator new[](size_t size) { return allocateOrThrow(size, DEFAULT_ALIGNMENT); }
+void* operator new(size_t size, std::align_val_t alignment) { return allocateOrThrow(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment) { return allocateOrThrow(size, static_cast<size_t>(alignment)); }
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return allocate(size ? size : 1, DEFAULT_ALIGNMENT); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return allocate(size ? size : 1, DEFAULT_ALIGNMENT); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate(size ? size : 1, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate(size ? size : 1, static_cast<size_t>(alignment));
+}
+
+void operator delete(void *pointer) noexcept { release(pointer); }
+void operator delete[](void *pointer) noexcept { release(pointer); }
+void operator delete(void *pointer, size_t) noexcept { release(pointer); }
+void operator delete[](void *pointer, size_t) noexcept { release(pointer); }
+void operator delete(void *pointer, std::align_val_t) noexcept { release(pointer); }
+void operator delete[](void *pointer, std::align_val_t) noexcept { release(pointer); }
+void operator delete(void *pointer, size_t, std::align_val_t) noexcept { release(pointer); }
+void operator delete[](void *pointer, size_t, std::align_val_t) noexcept { release(pointer); }
+void operator delete(void *pointer, const std::nothrow_t&) noexcept { release(pointer); }
+void operator delete[](void *pointer, const std::nothrow_t&) noexcept { release(pointer); }
+void operator delete(void *pointer, std::align_val_t, const std::nothrow_t&) noexcept { release(pointer); }
+void operator delete[](void *pointer, std::align_val_t, const std::nothrow_t&) noexcept { release(pointer); }
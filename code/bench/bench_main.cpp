@@ -0,0 +1,345 @@
+#include "benchmark.hpp"
+#include "scaling.hpp"
+#include "graph_reader.hpp"
+#include "graph_families.hpp"
+#include "randomizer.hpp"
+#include "alloc_tracker.hpp"
+#include "trace.hpp"
+#include "scheduler.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+    void printUsage(std::ostream& out) {
+        out << "Usage: GraphBench [options]" << std::endl
+            << std::endl
+            << "Datasets (repeatable, at least one):" << std::endl
+            << "  --dataset PATH        .graph file, or folder with .graph files" << std::endl
+            << "  --generate N          Seeded Eulerian graph with N vertices (see --density)" << std::endl
+            << "  --study               Scaling study: every --sizes x --densities Eulerian graph, with growth fits" << std::endl
+            << "  --family NAME:ARGS    rmat:SCALE[,FACTOR] grid:RxC cactus:CYCLES[,LEN] blockchain:BxS" << std::endl
+            << "                        barbell:K,PATH star:N path:N" << std::endl
+            << std::endl
+            << "Run:" << std::endl
+            << "  --engine NAME         Repeatable, default tarjan. One of:";
+        for (const bench::Engine& engine : bench::engines()) out << " " << engine.name;
+        out << std::endl
+            << "  --repetitions N       Timed iterations (default 10)" << std::endl
+            << "  --warmup N            Untimed iterations before them (default 2)" << std::endl
+            << "  --flush-cache         Sweep a 64MB buffer before every iteration" << std::endl
+            << "  --flush-bytes N       Size of the swept buffer" << std::endl
+            << "  --counters            Hardware counters per phase (perf_event_open), timers otherwise" << std::endl
+            << "  --memory              Allocations, heap and RSS peaks per phase" << std::endl
+            << "  --stats               Edges scanned, vertices visited, stack high-water, oracle calls (one extra run)" << std::endl
+            << "  --trace FILE          Chrome trace of the whole run (chrome://tracing, ui.perfetto.dev)" << std::endl
+            << "  --density F           Edge density of --generate (default 0.003)" << std::endl
+            << "  --seed N              Seed of generated datasets (default 1)" << std::endl
+            << "  --threads N           Threads of the shared scheduler (default GRAPH_THREADS or every core)" << std::endl
+            << "  --sizes LIST          Vertex counts of --study (default 100,1000,5000,15000)" << std::endl
+            << "  --densities LIST      Densities of --study (default 0.003)" << std::endl
+            << std::endl
+            << "Baselines:" << std::endl
+            << "  --save-baseline FILE  Stores the samples of this run, see --label" << std::endl
+            << "  --label TEXT          Version recorded on the baseline (e.g. a commit)" << std::endl
+            << "  --compare FILE        Compares with a baseline, exit code 3 on significant slowdowns" << std::endl
+            << "  --alpha F             Significance of the comparison (default 0.01)" << std::endl
+            << "  --threshold F         Smallest relative slowdown flagged (default 0.05)" << std::endl
+            << std::endl
+            << "Output:" << std::endl
+            << "  --format text|json|csv (default text)" << std::endl
+            << "  --output FILE         Defaults to stdout" << std::endl;
+    }
+
+    bool parseNumber(const std::string& text, long long& value) {
+        char *end = nullptr;
+        value = std::strtoll(text.c_str(), &end, 10);
+        return !text.empty() && end != nullptr && *end == '\0';
+    }
+
+    std::vector<double> parseDoubles(const std::string& text) {
+        std::vector<double> values;
+        std::string item;
+        std::stringstream stream(text);
+        while (std::getline(stream, item, ',')) {
+            if (!item.empty()) values.push_back(std::atof(item.c_str()));
+        }
+        return values;
+    }
+
+    /// @brief Numbers of "a,b" or "axb"
+    std::vector<long long> parseList(const std::string& text) {
+        std::vector<long long> values;
+        std::string item;
+        std::stringstream stream(text);
+        while (std::getline(stream, item, ',')) {
+            size_t cross = item.find('x');
+            for (const std::string& piece : {item.substr(0, cross), cross == std::string::npos ? std::string() : item.substr(cross + 1)}) {
+                long long value;
+                if (!piece.empty() && parseNumber(piece, value)) values.push_back(value);
+            }
+        }
+        return values;
+    }
+
+    Response<graphfamily::FamilyGraph> makeFamily(const std::string& spec, uint64_t seed) {
+        size_t colon = spec.find(':');
+        std::string name = spec.substr(0, colon);
+        std::vector<long long> args = colon == std::string::npos ? std::vector<long long>() : parseList(spec.substr(colon + 1));
+        auto arg = [&](size_t i, long long fallback) { return static_cast<int>(i < args.size() ? args[i] : fallback); };
+
+        if (name == "rmat") return graphfamily::rmat(arg(0, 14), arg(1, 8), seed);
+        if (name == "grid") return graphfamily::grid(arg(0, 300), arg(1, 300));
+        if (name == "cactus") return graphfamily::cactus(arg(0, 5000), arg(1, 5), 0.3f, seed);
+        if (name == "blockchain") return graphfamily::blockChain(arg(0, 500), arg(1, 100), 2.0f, seed);
+        if (name == "barbell") return graphfamily::barbell(arg(0, 200), arg(1, 1000));
+        if (name == "star") return graphfamily::star(arg(0, 100000));
+        if (name == "path") return graphfamily::deepPath(arg(0, 50000));
+        return Response<graphfamily::FamilyGraph>(ErrorCode::INVALID_ARGUMENT, "Unknown family: " + name);
+    }
+
+    /// @brief A file, or every .graph file of a folder in name order
+    bool loadDatasets(const std::string& path, std::vector<bench::Dataset>& datasets, perfcounters::CounterSet& counters) {
+        std::vector<std::string> files;
+        if (std::filesystem::is_directory(path)) {
+            for (const auto& entry : std::filesystem::directory_iterator(path)) {
+                if (entry.path().extension() == ".graph") files.push_back(entry.path().string());
+            }
+            std::sort(files.begin(), files.end());
+        } else {
+            files.push_back(path);
+        }
+
+        std::vector<char> ioBuffer(64 * 1024);
+        for (const std::string& file : files) {
+            perfcounters::PhaseRecorder phases(&counters);
+            phases.start("read");
+            Response<Graph> res = graphformat::readGraphFromFile(file, ioBuffer);
+            phases.stop();
+            if (!res.isOk()) {
+                std::cerr << file << ": " << res.describe() << std::endl;
+                return false;
+            }
+            datasets.push_back({file, std::move(res.value), phases.phases().front()});
+        }
+        return true;
+    }
+}
+
+
+int main(int argc, char **argv) {
+    bench::BenchmarkOptions options;
+    std::vector<std::string> datasetPaths, families, engineNames;
+    std::vector<long long> generated;
+    std::string format = "text", outputPath, traceFile;
+    double density = 0.003;
+    long long seed = 1;
+
+    bool study = false;
+    std::vector<long long> sizes = {100, 1000, 5000, 15000};
+    std::vector<double> densities;
+    std::string baselineOutput, baselineLabel = "unlabeled", baselineInput;
+    bench::CompareOptions compare;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << std::endl;
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+        auto number = [&]() -> long long {
+            std::string text = value();
+            long long parsed;
+            if (!parseNumber(text, parsed) || parsed < 0) {
+                std::cerr << "Invalid number for " << arg << ": " << text << std::endl;
+                std::exit(2);
+            }
+            return parsed;
+        };
+
+        if (arg == "--dataset") datasetPaths.push_back(value());
+        else if (arg == "--generate") generated.push_back(number());
+        else if (arg == "--family") families.push_back(value());
+        else if (arg == "--engine") engineNames.push_back(value());
+        else if (arg == "--repetitions") options.repetitions = static_cast<int>(std::max(1LL, number()));
+        else if (arg == "--warmup") options.warmup = static_cast<int>(number());
+        else if (arg == "--flush-cache") options.flushCache = true;
+        else if (arg == "--flush-bytes") options.flushBytes = static_cast<size_t>(number());
+        else if (arg == "--counters") options.counters = true;
+        else if (arg == "--memory") options.memory = true;
+        else if (arg == "--stats") options.algorithmStats = true;
+        else if (arg == "--trace") traceFile = value();
+        else if (arg == "--density") density = std::atof(value().c_str());
+        else if (arg == "--seed") seed = number();
+        else if (arg == "--threads") sched::setThreadCount(static_cast<unsigned>(number()));
+        else if (arg == "--study") study = true;
+        else if (arg == "--sizes") sizes = parseList(value());
+        else if (arg == "--densities") densities = parseDoubles(value());
+        else if (arg == "--save-baseline") baselineOutput = value();
+        else if (arg == "--label") baselineLabel = value();
+        else if (arg == "--compare") baselineInput = value();
+        else if (arg == "--alpha") compare.alpha = std::atof(value().c_str());
+        else if (arg == "--threshold") compare.threshold = std::atof(value().c_str());
+        else if (arg == "--format") format = value();
+        else if (arg == "--output") outputPath = value();
+        else if (arg == "--help" || arg == "-h") {
+            printUsage(std::cout);
+            return 0;
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            printUsage(std::cerr);
+            return 2;
+        }
+    }
+
+    if (format != "text" && format != "json" && format != "csv") {
+        std::cerr << "Unknown format: " << format << std::endl;
+        return 2;
+    }
+    if (engineNames.empty()) engineNames.push_back("tarjan");
+
+    std::vector<const bench::Engine*> selected;
+    for (const std::string& name : engineNames) {
+        const bench::Engine *engine = bench::findEngine(name);
+        if (engine == nullptr) {
+            std::cerr << "Unknown engine: " << name << std::endl;
+            return 2;
+        }
+        selected.push_back(engine);
+    }
+
+
+    perfcounters::CounterSet counters(options.counters);
+    if (options.counters && !counters.status().empty()) {
+        std::cerr << "warning: " << counters.status()
+                  << (counters.anyAvailable() ? ", reporting the remaining counters" : ", reporting timers only") << std::endl;
+    }
+
+    if (!traceFile.empty()) {
+        tracing::setThreadName("main");
+        tracing::start();
+    }
+
+    if (options.memory) {
+        if (!alloctracker::hooked()) std::cerr << "warning: allocation hooks not linked, heap columns stay at zero" << std::endl;
+        alloctracker::setEnabled(true);
+    }
+
+    // Datasets
+    std::vector<bench::Dataset> datasets;
+    for (const std::string& path : datasetPaths) {
+        if (!loadDatasets(path, datasets, counters)) return 1;
+    }
+    // Generated graphs are named eulerian-<size>-<density>, which groups them for the growth fits
+    std::vector<std::pair<long long, double>> grid;
+    for (long long n : generated) grid.push_back({n, density});
+    if (study) {
+        if (densities.empty()) densities.push_back(density);
+        for (double d : densities) {
+            for (long long n : sizes) grid.push_back({n, d});
+        }
+    }
+    for (const auto& [n, d] : grid) {
+        std::ostringstream name;
+        name << "eulerian-" << n << "-" << d;
+
+        randomgraph::GeneratorOptions generator;
+        generator.seed = static_cast<uint64_t>(seed);
+        Response<Graph> res = randomgraph::createEulerianGraph(static_cast<int>(n), static_cast<float>(d), generator);
+        if (!res.isOk()) {
+            std::cerr << name.str() << ": " << res.describe() << std::endl;
+            return 1;
+        }
+        datasets.push_back({name.str(), std::move(res.value), perfcounters::Phase()});
+    }
+    for (const std::string& spec : families) {
+        Response<graphfamily::FamilyGraph> res = makeFamily(spec, static_cast<uint64_t>(seed));
+        if (!res.isOk()) {
+            std::cerr << spec << ": " << res.describe() << std::endl;
+            return 1;
+        }
+        datasets.push_back({res.value.name, std::move(res.value.graph), perfcounters::Phase()});
+    }
+    if (datasets.empty()) {
+        std::cerr << "No datasets given" << std::endl;
+        printUsage(std::cerr);
+        return 2;
+    }
+
+
+    // Runs
+    std::vector<bench::BenchmarkResult> results;
+    for (const bench::Dataset& dataset : datasets) {
+        for (const bench::Engine *engine : selected) {
+            std::cerr << "running " << engine->name << " on " << dataset.name << std::endl;
+            Response<bench::BenchmarkResult> res = bench::runBenchmark(dataset, *engine, options, &counters);
+            if (!res.isOk()) {
+                std::cerr << res.describe() << std::endl;
+                return 1;
+            }
+            results.push_back(std::move(res.value));
+        }
+    }
+
+    if (!traceFile.empty()) {
+        tracing::stop();
+        Response<void> written = tracing::writeChromeTrace(traceFile);
+        if (!written.isOk()) {
+            std::cerr << traceFile << ": " << written.describe() << std::endl;
+            return 1;
+        }
+    }
+
+    std::ofstream file;
+    if (!outputPath.empty()) {
+        file.open(outputPath, std::ios::trunc);
+        if (!file) {
+            std::cerr << "Error: Could not open output file for writing" << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = outputPath.empty() ? std::cout : file;
+
+    if (format == "json") bench::writeJson(results, out);
+    else if (format == "csv") bench::writeCsv(results, out);
+    else bench::writeText(results, out);
+
+    // Reports stay human readable, next to the results only on text output
+    std::ostream& report = format == "text" ? out : std::cerr;
+    if (study) bench::writeFitsText(bench::fitGrowth(results), report);
+
+    if (!baselineOutput.empty()) {
+        Response<void> saved = bench::saveBaseline(baselineOutput, baselineLabel, results);
+        if (!saved.isOk()) {
+            std::cerr << baselineOutput << ": " << saved.describe() << std::endl;
+            return 1;
+        }
+    }
+
+    if (!baselineInput.empty()) {
+        Response<bench::Baseline> baseline = bench::loadBaseline(baselineInput);
+        if (!baseline.isOk()) {
+            std::cerr << baselineInput << ": " << baseline.describe() << std::endl;
+            return 1;
+        }
+
+        std::vector<bench::Comparison> comparisons = bench::compareToBaseline(results, baseline.value, compare);
+        bench::writeComparisonsText(comparisons, baseline.value, report);
+        for (const bench::Comparison& comparison : comparisons) {
+            if (comparison.regression) return 3;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,428 @@
+#include "benchmark.hpp"
+#include "tarjan.hpp"
+#include "naive.hpp"
+#include "eulerian.hpp"
+#include "csr_graph.hpp"
+#include "compressed_graph.hpp"
+#include "trace.hpp"
+#include "partitioned.hpp"
+#include "streaming.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <memory>
+#include <numeric>
+
+
+namespace bench {
+
+    //---- Estatísticas ----//
+
+    double percentile(const std::vector<double>& sorted, double fraction) {
+        if (sorted.empty()) return 0;
+
+        double position = fraction * (sorted.size() - 1);
+        size_t below = static_cast<size_t>(std::floor(position));
+        size_t above = std::min(below + 1, sorted.size() - 1);
+        double weight = position - below;
+        return sorted[below] * (1 - weight) + sorted[above] * weight;
+    }
+
+    Statistics summarize(std::vector<double> samples) {
+        Statistics stats;
+        stats.samples = samples.size();
+        if (samples.empty()) return stats;
+
+        std::sort(samples.begin(), samples.end());
+        stats.min = samples.front();
+        stats.max = samples.back();
+        stats.median = percentile(samples, 0.50);
+        stats.p95 = percentile(samples, 0.95);
+        stats.p99 = percentile(samples, 0.99);
+        stats.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+
+        if (samples.size() > 1) {
+            double squares = 0;
+            for (double sample : samples) squares += (sample - stats.mean) * (sample - stats.mean);
+            stats.stddev = std::sqrt(squares / (samples.size() - 1));
+        }
+        return stats;
+    }
+
+
+    //---- Engines ----//
+
+    using perfcounters::PhaseRecorder;
+
+    using algostats::CountingStats;
+
+    // Engines that only read the graph
+    template <typename Run, typename Count>
+    EngineRun __readOnly(Run run, Count count) {
+        return EngineRun{[]() {}, run, count};
+    }
+
+    template <typename Run>
+    EngineRun __readOnly(Run run) {
+        return EngineRun{[]() {}, run, nullptr};
+    }
+
+    // Engines that consume the graph get a fresh clone before every iteration
+    template <typename Run, typename Count>
+    EngineRun __consuming(const Graph& graph, Run run, Count count) {
+        auto scratch = std::make_shared<Graph>();
+        return EngineRun{
+            [scratch, &graph]() { *scratch = Graph::clone(graph); },
+            [scratch, run](PhaseRecorder& phases) { return run(*scratch, phases); },
+            [scratch, count](CountingStats& stats) { return count(*scratch, stats); }
+        };
+    }
+
+    // Search followed by the canonical (min, max) sorted bridge list
+    template <typename G>
+    size_t __tarjanPhases(const G& graph, PhaseRecorder& phases) {
+        phases.start("dfs");
+        auto bridges = tarjan(graph);
+        phases.stop();
+
+        PhaseRecorder::Scope scope(phases, "bridges");
+        for (auto& [u, v] : bridges) {
+            if (u > v) std::swap(u, v);
+        }
+        std::sort(bridges.begin(), bridges.end());
+        return bridges.size();
+    }
+
+    const std::vector<Engine>& engines() {
+        static const std::vector<Engine> all = {
+            {"tarjan", [](const Graph& graph) {
+                return __readOnly([&graph](PhaseRecorder& phases) { return __tarjanPhases(graph, phases); },
+                                  [&graph](CountingStats& stats) { return tarjan(graph, stats).size(); });
+            }},
+            {"tarjan-csr", [](const Graph& graph) {
+                auto csr = std::make_shared<CsrGraph>(CsrGraph::fromGraph(graph));
+                return __readOnly([csr](PhaseRecorder& phases) { return __tarjanPhases(*csr, phases); },
+                                  [csr](CountingStats& stats) { return tarjan(*csr, stats).size(); });
+            }},
+            {"tarjan-compressed", [](const Graph& graph) {
+                auto compressed = std::make_shared<CompressedGraph>(CompressedGraph::compress(graph));
+                return __readOnly([compressed](PhaseRecorder& phases) { return __tarjanPhases(*compressed, phases); },
+                                  [compressed](CountingStats& stats) { return tarjan(*compressed, stats).size(); });
+            }},
+            {"tarjan-partitioned", [](const Graph& graph) {
+                return __readOnly([&graph](PhaseRecorder& phases) -> Response<size_t> {
+                    PhaseRecorder::Scope scope(phases, "bridges");
+                    Response<EdgeVector> bridges = partitioned::findBridges(graph);
+                    if (!bridges.isOk()) return Response<size_t>(bridges.code, bridges.describe());
+                    return Response<size_t>(bridges.value.size());
+                });
+            }},
+            {"tarjan-partitioned-fork", [](const Graph& graph) {
+                return __readOnly([&graph](PhaseRecorder& phases) -> Response<size_t> {
+                    PhaseRecorder::Scope scope(phases, "bridges");
+                    partitioned::PartitionOptions options;
+                    options.transport = transport::Kind::PROCESSES;
+                    Response<EdgeVector> bridges = partitioned::findBridges(graph, options);
+                    if (!bridges.isOk()) return Response<size_t>(bridges.code, bridges.describe());
+                    return Response<size_t>(bridges.value.size());
+                });
+            }},
+            {"tarjan-certificate", [](const Graph& graph) {
+                return __readOnly([&graph](PhaseRecorder& phases) {
+                    PhaseRecorder::Scope scope(phases, "bridges");
+                    return streaming::findBridges(graph).size();
+                });
+            }},
+            {"naive", [](const Graph& graph) {
+                return __consuming(graph, [](Graph& scratch, PhaseRecorder& phases) {
+                    PhaseRecorder::Scope scope(phases, "naive");
+                    return executeNaive(scratch).size();
+                }, [](Graph& scratch, CountingStats& stats) { return executeNaive(scratch, stats).size(); });
+            }},
+            {"euler-tarjan", [](const Graph& graph) {
+                return __consuming(graph, [](Graph& scratch, PhaseRecorder& phases) {
+                    PhaseRecorder::Scope scope(phases, "euler");
+                    return findEulerianPathTarjan(scratch).size();
+                }, [](Graph& scratch, CountingStats& stats) { return findEulerianPathTarjan(scratch, stats).size(); });
+            }},
+            {"euler-naive", [](const Graph& graph) {
+                return __consuming(graph, [](Graph& scratch, PhaseRecorder& phases) {
+                    PhaseRecorder::Scope scope(phases, "euler");
+                    return findEulerianPathNaive(scratch).size();
+                }, [](Graph& scratch, CountingStats& stats) { return findEulerianPathNaive(scratch, stats).size(); });
+            }},
+            {"hierholzer", [](const Graph& graph) {
+                auto compressed = std::make_shared<CompressedGraph>(CompressedGraph::compress(graph));
+                return __readOnly([compressed](PhaseRecorder& phases) {
+                    PhaseRecorder::Scope scope(phases, "euler");
+                    return findEulerianPathHierholzer(*compressed).size();
+                });
+            }},
+        };
+        return all;
+    }
+
+    const Engine* findEngine(const std::string& name) {
+        for (const Engine& engine : engines()) {
+            if (engine.name == name) return &engine;
+        }
+        return nullptr;
+    }
+
+
+    //---- Execução ----//
+
+    // Keeps the flush loop from being optimized away
+    volatile unsigned char flushSink = 0;
+
+    void flushCaches(size_t bytes) {
+        static std::vector<unsigned char> buffer;
+        if (buffer.size() < bytes) buffer.resize(bytes);
+
+        unsigned char sum = 0;
+        for (size_t i = 0; i < bytes; i += 64) {
+            buffer[i] = static_cast<unsigned char>(buffer[i] + 1);
+            sum ^= buffer[i];
+        }
+        flushSink = sum;
+    }
+
+    Response<BenchmarkResult> runBenchmark(const Dataset& dataset, const Engine& engine, const BenchmarkOptions& options,
+                                           perfcounters::CounterSet *counters) {
+        BenchmarkResult result;
+        result.dataset = dataset.name;
+        result.vertices = dataset.graph.getVertexQuantity();
+        result.edges = dataset.graph.getTotalQuantityEdges();
+        result.engine = engine.name;
+        result.options = options;
+        result.samples.reserve(options.repetitions);
+
+        // Conversions done by prepare() are the build phase, measured once
+        PhaseRecorder build(counters);
+        EngineRun prepared;
+        {
+            TRACE_SPAN("build");
+            build.start("build");
+            prepared = engine.prepare(dataset.graph);
+            build.stop();
+        }
+
+        PhaseRecorder warmup, timed(counters);
+        for (int i = 0; i < options.warmup + options.repetitions; i++) {
+            PhaseRecorder& phases = i < options.warmup ? warmup : timed;
+            TRACE_SPAN(i < options.warmup ? "warmup" : "iteration");
+            {
+                TRACE_SPAN("reset");
+                prepared.reset();
+                if (options.flushCache) flushCaches(options.flushBytes);
+            }
+
+            std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+            Response<size_t> answer = prepared.run(phases);
+            std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+            if (!answer.isOk()) {
+                return Response<BenchmarkResult>(answer.code, engine.name + " on " + dataset.name + ": " + answer.describe());
+            }
+
+            result.answer = answer.value;
+            if (i >= options.warmup) {
+                result.samples.push_back(std::chrono::duration<double, std::micro>(end - begin).count());
+            }
+        }
+
+        if (options.algorithmStats && prepared.count) {
+            prepared.reset();
+            prepared.count(result.counts);
+            result.counted = true;
+        }
+
+        if (dataset.read.calls > 0) result.phases.push_back(dataset.read);
+        result.phases.insert(result.phases.end(), build.phases().begin(), build.phases().end());
+        result.phases.insert(result.phases.end(), timed.phases().begin(), timed.phases().end());
+
+        for (const perfcounters::Phase& phase : result.phases) {
+            result.heapPeak = std::max(result.heapPeak, phase.total.heapPeak);
+        }
+
+        result.stats = summarize(result.samples);
+        return Response<BenchmarkResult>(std::move(result));
+    }
+
+
+    //---- Saída ----//
+
+    std::string __jsonEscape(const std::string& text) {
+        const char *hex = "0123456789abcdef";
+        std::string escaped;
+        for (char c : text) {
+            unsigned char byte = static_cast<unsigned char>(c);
+            if (c == '"' || c == '\\') {
+                escaped += '\\';
+                escaped += c;
+            } else if (byte < 0x20) {
+                // Raw control characters are not allowed inside JSON strings
+                escaped += "\\u00";
+                escaped += hex[byte >> 4];
+                escaped += hex[byte & 0xf];
+            } else {
+                escaped += c;
+            }
+        }
+        return escaped;
+    }
+
+    std::string __csvField(const std::string& text) {
+        if (text.find_first_of(",\"\n") == std::string::npos) return text;
+        std::string quoted = "\"";
+        for (char c : text) {
+            if (c == '"') quoted += '"';
+            quoted += c;
+        }
+        return quoted + "\"";
+    }
+
+    double __megabytes(uint64_t bytes) {
+        return bytes / (1024.0 * 1024.0);
+    }
+
+    void __writePhaseText(const perfcounters::Phase& phase, std::ostream& out) {
+        perfcounters::CounterSample average = phase.average();
+        out << "  " << phase.name << ": " << average.micro << " [micro] x" << phase.calls;
+
+        bool any = false;
+        for (int i = 0; i < perfcounters::COUNTER_QUANTITY; i++) {
+            if (!average.available[i]) continue;
+            out << " | " << perfcounters::counterName(i) << " " << average.values[i];
+            any = true;
+        }
+        if (!any) {
+            out << " | counters n/a";
+        } else if (average.available[perfcounters::CYCLES] && average.available[perfcounters::INSTRUCTIONS]
+                   && average.values[perfcounters::CYCLES] > 0) {
+            out << " | ipc " << static_cast<double>(average.values[perfcounters::INSTRUCTIONS]) / average.values[perfcounters::CYCLES];
+        }
+        if (average.memory) {
+            out << " | allocs " << average.allocations << " (" << __megabytes(average.allocatedBytes) << " MB)"
+                << " | heap peak " << __megabytes(average.heapPeak) << " MB | rss peak " << __megabytes(average.rssPeak) << " MB";
+        }
+        out << std::endl;
+    }
+
+    void writeText(const std::vector<BenchmarkResult>& results, std::ostream& out) {
+        out << std::fixed << std::setprecision(2);
+        for (const BenchmarkResult& result : results) {
+            const Statistics& s = result.stats;
+            out << "# " << result.dataset << " (V: " << result.vertices << ", E: " << result.edges << ")"
+                << " - " << result.engine << ", answer: " << result.answer << std::endl;
+            out << "  min " << s.min << " | median " << s.median << " | p95 " << s.p95 << " | p99 " << s.p99
+                << " | mean " << s.mean << " | stddev " << s.stddev << " | max " << s.max
+                << " [micro], " << s.samples << " samples";
+            if (result.options.memory) out << ", memory " << __megabytes(result.heapPeak) << " MB";
+            out << std::endl;
+            if (result.counted) {
+                const algostats::CountingStats& c = result.counts;
+                out << "  edges scanned " << c.edgesScanned << " | vertices visited " << c.verticesVisited
+                    << " | stack high-water " << c.stackHighWater << " | traversals " << c.traversals
+                    << " | oracle calls " << c.oracleCalls << std::endl;
+            }
+            for (const perfcounters::Phase& phase : result.phases) __writePhaseText(phase, out);
+        }
+    }
+
+    void writeJson(const std::vector<BenchmarkResult>& results, std::ostream& out) {
+        out << std::setprecision(6);
+        out << "{\"unit\": \"us\", \"benchmarks\": [" << std::endl;
+        for (size_t i = 0; i < results.size(); i++) {
+            const BenchmarkResult& result = results[i];
+            const Statistics& s = result.stats;
+
+            out << "  {\"dataset\": \"" << __jsonEscape(result.dataset) << "\", \"vertices\": " << result.vertices
+                << ", \"edges\": " << result.edges << ", \"engine\": \"" << __jsonEscape(result.engine) << "\""
+                << ", \"answer\": " << result.answer
+                << ", \"repetitions\": " << result.options.repetitions << ", \"warmup\": " << result.options.warmup
+                << ", \"flushCache\": " << (result.options.flushCache ? "true" : "false")
+                << ", \"min\": " << s.min << ", \"median\": " << s.median << ", \"p95\": " << s.p95
+                << ", \"p99\": " << s.p99 << ", \"mean\": " << s.mean << ", \"stddev\": " << s.stddev
+                << ", \"max\": " << s.max;
+            if (result.options.memory) out << ", \"heapPeakBytes\": " << result.heapPeak;
+            if (result.counted) {
+                const algostats::CountingStats& c = result.counts;
+                out << ", \"algorithm\": {\"edgesScanned\": " << c.edgesScanned << ", \"verticesVisited\": " << c.verticesVisited
+                    << ", \"stackHighWater\": " << c.stackHighWater << ", \"traversals\": " << c.traversals
+                    << ", \"oracleCalls\": " << c.oracleCalls << "}";
+            }
+            out << ", \"samples\": [";
+            for (size_t k = 0; k < result.samples.size(); k++) {
+                out << (k ? ", " : "") << result.samples[k];
+            }
+
+            // Counters that could not be read are null
+            out << "], \"phases\": [";
+            for (size_t k = 0; k < result.phases.size(); k++) {
+                const perfcounters::Phase& phase = result.phases[k];
+                perfcounters::CounterSample average = phase.average();
+                out << (k ? ", " : "") << "{\"name\": \"" << __jsonEscape(phase.name) << "\", \"calls\": " << phase.calls
+                    << ", \"us\": " << average.micro;
+                for (int c = 0; c < perfcounters::COUNTER_QUANTITY; c++) {
+                    out << ", \"" << perfcounters::counterName(c) << "\": ";
+                    if (average.available[c]) out << average.values[c];
+                    else out << "null";
+                }
+                if (average.memory) {
+                    out << ", \"allocations\": " << average.allocations << ", \"allocatedBytes\": " << average.allocatedBytes
+                        << ", \"heapPeakBytes\": " << average.heapPeak << ", \"rssPeakBytes\": " << average.rssPeak;
+                }
+                out << "}";
+            }
+            out << "]}" << (i + 1 < results.size() ? "," : "") << std::endl;
+        }
+        out << "]}" << std::endl;
+    }
+
+    void writeCsv(const std::vector<BenchmarkResult>& results, std::ostream& out) {
+        out << std::setprecision(6);
+        out << "dataset,vertices,edges,engine,answer,repetitions,warmup,flush_cache,"
+            << "min_us,median_us,p95_us,p99_us,mean_us,stddev_us,max_us,memory_bytes,"
+            << "edges_scanned,vertices_visited,stack_high_water,traversals,oracle_calls,phase,phase_calls,phase_us";
+        for (int c = 0; c < perfcounters::COUNTER_QUANTITY; c++) out << "," << perfcounters::counterName(c);
+        out << ",allocations,allocated_bytes,heap_peak_bytes,rss_peak_bytes" << std::endl;
+
+        // One row per phase, the run columns repeat so every row stands alone
+        for (const BenchmarkResult& result : results) {
+            const Statistics& s = result.stats;
+            std::vector<perfcounters::Phase> phases = result.phases;
+            if (phases.empty()) phases.push_back(perfcounters::Phase());
+
+            for (const perfcounters::Phase& phase : phases) {
+                perfcounters::CounterSample average = phase.average();
+                out << __csvField(result.dataset) << "," << result.vertices << "," << result.edges << ","
+                    << result.engine << "," << result.answer << "," << result.options.repetitions << ","
+                    << result.options.warmup << "," << (result.options.flushCache ? 1 : 0) << ","
+                    << s.min << "," << s.median << "," << s.p95 << "," << s.p99 << ","
+                    << s.mean << "," << s.stddev << "," << s.max << ",";
+                if (result.options.memory) out << result.heapPeak;
+                if (result.counted) {
+                    const algostats::CountingStats& c = result.counts;
+                    out << "," << c.edgesScanned << "," << c.verticesVisited << "," << c.stackHighWater
+                        << "," << c.traversals << "," << c.oracleCalls;
+                } else {
+                    out << ",,,,,";
+                }
+                out << "," << phase.name << "," << phase.calls << "," << average.micro;
+                for (int c = 0; c < perfcounters::COUNTER_QUANTITY; c++) {
+                    out << ",";
+                    if (average.available[c]) out << average.values[c];
+                }
+                if (average.memory) {
+                    out << "," << average.allocations << "," << average.allocatedBytes << ","
+                        << average.heapPeak << "," << average.rssPeak;
+                } else {
+                    out << ",,,,";
+                }
+                out << std::endl;
+            }
+        }
+    }
+}
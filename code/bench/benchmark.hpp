@@ -0,0 +1,114 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "graph.hpp"
+#include "perf_counters.hpp"
+#include "algorithm_stats.hpp"
+#include "response_struct.hpp"
+
+
+/**
+ * @brief Benchmark driver used by the GraphBench target
+ *
+ * Every (dataset, engine) pair runs `warmup` untimed iterations followed by `repetitions`
+ * timed ones. Work that is not part of the engine (cloning graphs consumed by Fleury,
+ * converting to CSR or compressed form) happens outside the timed region.
+ *
+ * Engines split their work in named phases (build, dfs, bridges, euler...). Each phase
+ * records wall time and, when a CounterSet is given and the machine allows it, hardware
+ * counters, averaged over the timed iterations.
+ *
+ * Algorithm statistics (edges scanned, stack high-water...) come from one extra untimed
+ * iteration with the CountingStats policy, so the timed samples keep the no-op policy.
+ */
+namespace bench {
+
+    /// @brief Summary of the samples of a run, in microseconds
+    struct Statistics {
+        size_t samples = 0;
+        double min = 0, max = 0;
+        double mean = 0, stddev = 0;  // Sample standard deviation (n - 1)
+        double median = 0, p95 = 0, p99 = 0;
+    };
+
+    /// @brief Linear interpolation between closest ranks, `sorted` must be ascending
+    double percentile(const std::vector<double>& sorted, double fraction);
+
+    Statistics summarize(std::vector<double> samples);
+
+
+    struct BenchmarkOptions {
+        int repetitions = 10;
+        int warmup = 2;
+        bool flushCache = false;               // Sweeps a buffer larger than the LLC before every iteration
+        size_t flushBytes = size_t(64) << 20;
+        bool counters = false;                 // Hardware counters were requested for the phases
+        bool memory = false;                   // Allocations and peak memory were requested for the phases
+        bool algorithmStats = false;           // Run once more with algostats::CountingStats
+    };
+
+    struct Dataset {
+        std::string name;
+        Graph graph;
+        perfcounters::Phase read;  // Loading of the dataset, no calls when it was generated
+    };
+
+    /// @brief Prepared engine: reset() runs untimed before every iteration, run() is timed
+    struct EngineRun {
+        std::function<void()> reset;
+        // Returns a size of the answer, also keeps the work observable. Phases are recorded on the argument,
+        // an error stops the benchmark run
+        std::function<Response<size_t>(perfcounters::PhaseRecorder&)> run;
+        // Same work with the counting policy, empty when the engine has no instrumented version
+        std::function<size_t(algostats::CountingStats&)> count;
+    };
+
+    struct Engine {
+        std::string name;
+        std::function<EngineRun(const Graph&)> prepare;
+    };
+
+    /// @brief Every engine known to the driver
+    const std::vector<Engine>& engines();
+
+    /// @brief Engine by name, nullptr when unknown
+    const Engine* findEngine(const std::string& name);
+
+
+    struct BenchmarkResult {
+        std::string dataset;
+        int vertices = 0;
+        long long edges = 0;
+        std::string engine;
+        size_t answer = 0;  // Bridges found or path length, as returned by the engine
+        BenchmarkOptions options;
+        std::vector<double> samples;
+        Statistics stats;
+        std::vector<perfcounters::Phase> phases;  // read (when loaded), build, then the engine phases
+        uint64_t heapPeak = 0;                    // Highest heap growth among the phases, 0 without memory tracking
+        bool counted = false;                     // `counts` was filled
+        algostats::CountingStats counts;
+    };
+
+    /// @brief `counters` null records the phases with timers only, fails on the first engine error
+    Response<BenchmarkResult> runBenchmark(const Dataset& dataset, const Engine& engine, const BenchmarkOptions& options,
+                                 perfcounters::CounterSet *counters = nullptr);
+
+    /// @brief Evicts the caches by writing and reading `bytes` of memory
+    void flushCaches(size_t bytes);
+
+
+    //---- Saída ----//
+
+    void writeText(const std::vector<BenchmarkResult>& results, std::ostream& out);
+    void writeJson(const std::vector<BenchmarkResult>& results, std::ostream& out);
+    void writeCsv(const std::vector<BenchmarkResult>& results, std::ostream& out);
+}
+
+
+#endif  // BENCHMARK_HPP
@@ -0,0 +1,244 @@
+#include "scaling.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+
+namespace bench {
+
+    //---- Ajuste de crescimento ----//
+
+    std::string __groupOf(const std::string& dataset) {
+        size_t dash = dataset.rfind('-');
+        if (dash == std::string::npos) return dataset;
+
+        // "eulerian-1000-0.003": the size is the component before the density
+        size_t previous = dataset.rfind('-', dash - 1);
+        if (previous != std::string::npos && std::all_of(dataset.begin() + previous + 1, dataset.begin() + dash, ::isdigit)) {
+            return dataset.substr(0, previous) + "-*" + dataset.substr(dash);
+        }
+        return dataset.substr(0, dash) + "-*";
+    }
+
+    std::vector<GrowthFit> fitGrowth(const std::vector<BenchmarkResult>& results) {
+        std::map<std::pair<std::string, std::string>, std::vector<const BenchmarkResult*>> groups;
+        for (const BenchmarkResult& result : results) {
+            if (result.stats.samples == 0 || result.stats.median <= 0) continue;
+            groups[{result.engine, __groupOf(result.dataset)}].push_back(&result);
+        }
+
+        std::vector<GrowthFit> fits;
+        for (const auto& [key, members] : groups) {
+            std::vector<double> xs, ys;
+            for (const BenchmarkResult *result : members) {
+                xs.push_back(std::log(static_cast<double>(result->vertices) + result->edges));
+                ys.push_back(std::log(result->stats.median));
+            }
+
+            double meanX = 0, meanY = 0;
+            for (size_t i = 0; i < xs.size(); i++) {
+                meanX += xs[i];
+                meanY += ys[i];
+            }
+            meanX /= xs.size();
+            meanY /= ys.size();
+
+            double sxx = 0, sxy = 0, syy = 0;
+            for (size_t i = 0; i < xs.size(); i++) {
+                sxx += (xs[i] - meanX) * (xs[i] - meanX);
+                sxy += (xs[i] - meanX) * (ys[i] - meanY);
+                syy += (ys[i] - meanY) * (ys[i] - meanY);
+            }
+            if (sxx <= 0) continue;  // A single size, nothing to fit
+
+            GrowthFit fit;
+            fit.engine = key.first;
+            fit.group = key.second;
+            fit.points = static_cast<int>(xs.size());
+            fit.exponent = sxy / sxx;
+            fit.coefficient = std::exp(meanY - fit.exponent * meanX);
+            fit.r2 = syy > 0 ? (sxy * sxy) / (sxx * syy) : 1;
+            fits.push_back(fit);
+        }
+        return fits;
+    }
+
+
+    //---- Baselines ----//
+
+    Response<void> saveBaseline(const std::string& filename, const std::string& label, const std::vector<BenchmarkResult>& results) {
+        std::ofstream out(filename, std::ios::trunc);
+        if (!out) return Response<void>(ErrorCode::OPEN_FAILED, "Error: Could not open baseline file for writing");
+
+        std::time_t now = std::time(nullptr);
+        char created[32];
+        std::strftime(created, sizeof(created), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+        out << "# graphbench baseline" << std::endl
+            << "version " << BASELINE_VERSION << std::endl
+            << "label " << label << std::endl
+            << "created " << created << std::endl;
+
+        out << std::setprecision(9);
+        for (const BenchmarkResult& result : results) {
+            // Dataset last, it is a path and may contain spaces
+            out << "result " << result.engine << " " << result.vertices << " " << result.edges << " "
+                << result.answer << " " << result.samples.size() << " " << result.dataset << std::endl;
+            out << "samples";
+            for (double sample : result.samples) out << " " << sample;
+            out << std::endl;
+        }
+
+        out.close();
+        if (!out) return Response<void>(ErrorCode::WRITE_FAILED, "Error: Could not write baseline file");
+        return Response<void>();
+    }
+
+    Response<Baseline> loadBaseline(const std::string& filename) {
+        std::ifstream in(filename);
+        if (!in) return Response<Baseline>(ErrorCode::OPEN_FAILED, "Error: Could not open baseline file for reading");
+
+        Baseline baseline;
+        baseline.version = 0;
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.empty() || line[0] == '#') continue;
+
+            std::istringstream fields(line);
+            std::string key;
+            fields >> key;
+
+            if (key == "version") {
+                fields >> baseline.version;
+                if (baseline.version != BASELINE_VERSION) {
+                    return Response<Baseline>(ErrorCode::INVALID_FORMAT, "Error: Baseline version " + std::to_string(baseline.version)
+                                              + " is not supported (expected " + std::to_string(BASELINE_VERSION) + ")");
+                }
+            } else if (key == "label") {
+                std::getline(fields >> std::ws, baseline.label);
+            } else if (key == "created") {
+                fields >> baseline.created;
+            } else if (key == "result") {
+                BenchmarkResult result;
+                size_t count = 0;
+                fields >> result.engine >> result.vertices >> result.edges >> result.answer >> count;
+                std::getline(fields >> std::ws, result.dataset);
+
+                std::string samples;
+                if (fields.fail() || !std::getline(in, samples)) {
+                    return Response<Baseline>(ErrorCode::INVALID_FORMAT, "Error: Malformed baseline entry: " + line);
+                }
+                std::istringstream values(samples);
+                values >> key;
+                double sample;
+                while (values >> sample) result.samples.push_back(sample);
+
+                if (key != "samples" || result.samples.size() != count) {
+                    return Response<Baseline>(ErrorCode::INVALID_FORMAT, "Error: Malformed samples of " + result.dataset);
+                }
+                result.stats = summarize(result.samples);
+                baseline.results.push_back(std::move(result));
+            } else {
+                return Response<Baseline>(ErrorCode::INVALID_FORMAT, "Error: Unknown baseline entry: " + key);
+            }
+        }
+
+        if (baseline.version == 0) return Response<Baseline>(ErrorCode::INVALID_FORMAT, "Error: Baseline without version");
+        return Response<Baseline>(std::move(baseline));
+    }
+
+
+    //---- Comparação ----//
+
+    double mannWhitneySlower(const std::vector<double>& baseline, const std::vector<double>& current) {
+        const size_t n1 = baseline.size(), n2 = current.size();
+        if (n1 == 0 || n2 == 0) return 1;
+
+        // Ranks of the pooled samples, ties get the average rank
+        std::vector<std::pair<double, bool>> pooled;  // (value, from current)
+        for (double value : baseline) pooled.push_back({value, false});
+        for (double value : current) pooled.push_back({value, true});
+        std::sort(pooled.begin(), pooled.end());
+
+        double rankSum = 0, tieTerm = 0;
+        for (size_t i = 0; i < pooled.size();) {
+            size_t j = i;
+            while (j < pooled.size() && pooled[j].first == pooled[i].first) j++;
+
+            double rank = (i + 1 + j) / 2.0;
+            for (size_t k = i; k < j; k++) {
+                if (pooled[k].second) rankSum += rank;
+            }
+            double ties = static_cast<double>(j - i);
+            tieTerm += ties * ties * ties - ties;
+            i = j;
+        }
+
+        const double n = static_cast<double>(n1 + n2);
+        double u = rankSum - n2 * (n2 + 1) / 2.0;  // Pairs where current is slower
+        double mean = n1 * n2 / 2.0;
+        double variance = n1 * n2 / 12.0 * ((n + 1) - tieTerm / (n * (n - 1)));
+        if (variance <= 0) return 1;
+
+        double z = (u - mean - 0.5) / std::sqrt(variance);
+        return 0.5 * std::erfc(z / std::sqrt(2.0));
+    }
+
+    std::vector<Comparison> compareToBaseline(const std::vector<BenchmarkResult>& current, const Baseline& baseline,
+                                              const CompareOptions& options) {
+        std::vector<Comparison> comparisons;
+        for (const BenchmarkResult& result : current) {
+            auto match = std::find_if(baseline.results.begin(), baseline.results.end(), [&](const BenchmarkResult& old) {
+                return old.engine == result.engine && old.dataset == result.dataset;
+            });
+            if (match == baseline.results.end() || match->stats.median <= 0) continue;
+
+            Comparison comparison;
+            comparison.dataset = result.dataset;
+            comparison.engine = result.engine;
+            comparison.baselineMedian = match->stats.median;
+            comparison.currentMedian = result.stats.median;
+            comparison.ratio = comparison.currentMedian / comparison.baselineMedian;
+            comparison.pValue = mannWhitneySlower(match->samples, result.samples);
+            comparison.answerChanged = match->answer != result.answer;
+            comparison.regression = comparison.pValue < options.alpha && comparison.ratio > 1 + options.threshold;
+            comparisons.push_back(comparison);
+        }
+        return comparisons;
+    }
+
+
+    //---- Saída ----//
+
+    void writeFitsText(const std::vector<GrowthFit>& fits, std::ostream& out) {
+        if (fits.empty()) return;
+
+        out << std::fixed << std::setprecision(3);
+        out << "## Growth (time ~ c * (V + E)^k)" << std::endl;
+        for (const GrowthFit& fit : fits) {
+            out << "  " << fit.engine << " on " << fit.group << ": k = " << fit.exponent
+                << ", c = " << std::scientific << fit.coefficient << std::fixed
+                << " [micro], r2 = " << fit.r2 << ", " << fit.points << " sizes" << std::endl;
+        }
+    }
+
+    void writeComparisonsText(const std::vector<Comparison>& comparisons, const Baseline& baseline, std::ostream& out) {
+        out << std::fixed << std::setprecision(3);
+        out << "## Baseline " << baseline.label << " (" << baseline.created << ")" << std::endl;
+        if (comparisons.empty()) out << "  no run matches the baseline" << std::endl;
+
+        for (const Comparison& comparison : comparisons) {
+            out << "  " << (comparison.regression ? "SLOWER " : "ok     ") << comparison.engine << " on " << comparison.dataset
+                << ": " << comparison.baselineMedian << " -> " << comparison.currentMedian << " [micro] (x"
+                << comparison.ratio << ", p = " << std::setprecision(4) << comparison.pValue << std::setprecision(3) << ")";
+            if (comparison.answerChanged) out << ", answer changed";
+            out << std::endl;
+        }
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef SCALING_HPP
+#define SCALING_HPP
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include "benchmark.hpp"
+#include "response_struct.hpp"
+
+
+/**
+ * @brief Scaling studies and regression detection on top of the benchmark driver
+ *
+ * The growth exponent of an engine is the slope of log(median time) against log(V + E)
+ * over graphs of the same density, fitted with least squares: ~1 for the linear searches,
+ * clearly above 1 for the naive removal.
+ *
+ * Baselines are the raw samples of a run stored on a versioned text file. A later run is
+ * matched by (dataset, engine) and compared with a one-sided Mann-Whitney U test, which
+ * makes no assumption on the (usually skewed) distribution of the timings.
+ */
+namespace bench {
+
+    struct GrowthFit {
+        std::string engine;
+        std::string group;       // Datasets of the same family and density
+        int points = 0;
+        double exponent = 0;     // time ~ (V + E)^exponent
+        double coefficient = 0;  // Microseconds at V + E = 1
+        double r2 = 0;
+    };
+
+    /**
+     * @brief Fits every (engine, group) with at least two distinct sizes
+     *
+     * The group of a result is its dataset name up to the last '-', so "eulerian-1000-0.003"
+     * and "eulerian-5000-0.003" share the group "eulerian-*-0.003".
+     */
+    std::vector<GrowthFit> fitGrowth(const std::vector<BenchmarkResult>& results);
+
+
+    const int BASELINE_VERSION = 1;
+
+    struct Baseline {
+        int version = BASELINE_VERSION;
+        std::string label;    // Free text, usually a commit or a release
+        std::string created;  // UTC, ISO 8601
+        std::vector<BenchmarkResult> results;  // Only dataset, sizes, engine, answer and samples are stored
+    };
+
+    Response<void> saveBaseline(const std::string& filename, const std::string& label, const std::vector<BenchmarkResult>& results);
+    Response<Baseline> loadBaseline(const std::string& filename);
+
+
+    struct Comparison {
+        std::string dataset;
+        std::string engine;
+        double baselineMedian = 0;
+        double currentMedian = 0;
+        double ratio = 0;        // currentMedian / baselineMedian
+        double pValue = 1;       // Probability of a slowdown this large by chance
+        bool answerChanged = false;
+        bool regression = false;
+    };
+
+    struct CompareOptions {
+        double alpha = 0.01;      // Significance of the test
+        double threshold = 0.05;  // Slowdowns below 5% of the median are never flagged
+    };
+
+    /// @brief One-sided Mann-Whitney U p-value of `current` being slower than `baseline`, normal approximation with ties
+    double mannWhitneySlower(const std::vector<double>& baseline, const std::vector<double>& current);
+
+    /// @brief Comparisons of the results that exist in the baseline, unmatched results are skipped
+    std::vector<Comparison> compareToBaseline(const std::vector<BenchmarkResult>& current, const Baseline& baseline,
+                                              const CompareOptions& options = CompareOptions());
+
+    void writeFitsText(const std::vector<GrowthFit>& fits, std::ostream& out);
+    void writeComparisonsText(const std::vector<Comparison>& comparisons, const Baseline& baseline, std::ostream& out);
+}
+
+
+#endif  // SCALING_HPP
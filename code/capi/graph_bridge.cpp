@@ -0,0 +1,138 @@
+#include "graph_bridge.h"
+#include "csr_graph.hpp"
+#include "tarjan.hpp"
+#include "eulerian.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <new>
+#include <vector>
+
+
+namespace {
+
+  //---- Métodos auxiliares ----//
+
+  /// @brief O(V) checks every entry point runs, the neighbours are only scanned by gb_validate
+  gb_status __checkOffsets(const gb_csr_view *graph) {
+    if (graph == nullptr || graph->vertex_count < 0) return GB_INVALID_ARGUMENT;
+    if (graph->vertex_count == 0) return GB_OK;
+    if (graph->offsets == nullptr || graph->offsets[0] != 0) return GB_INVALID_ARGUMENT;
+
+    for (int32_t v = 0; v < graph->vertex_count; v++) {
+      if (graph->offsets[v + 1] < graph->offsets[v]) return GB_INVALID_ARGUMENT;
+    }
+    uint64_t halfEdges = graph->offsets[graph->vertex_count];
+    if (halfEdges % 2 != 0 || halfEdges / 2 > static_cast<uint64_t>(INT_MAX)) return GB_INVALID_ARGUMENT;
+    if (halfEdges > 0 && graph->neighbours == nullptr) return GB_INVALID_ARGUMENT;
+    return GB_OK;
+  }
+
+  CsrView __view(const gb_csr_view *graph) {
+    return CsrView(graph->vertex_count, graph->offsets, graph->neighbours);
+  }
+
+  /// @brief Keeps C++ exceptions (only allocation failures are expected) from crossing the C boundary
+  template <typename F>
+  gb_status __guard(F fn) {
+    try {
+      return fn();
+    } catch (const std::bad_alloc&) {
+      return GB_OUT_OF_MEMORY;
+    } catch (...) {
+      return GB_INTERNAL_ERROR;
+    }
+  }
+}
+
+
+//---- Métodos públicos ----//
+
+extern "C" {
+
+  int gb_api_version(void) {
+    return GB_API_VERSION;
+  }
+
+  const char *gb_status_string(gb_status status) {
+    switch (status) {
+      case GB_OK: return "Ok";
+      case GB_INVALID_ARGUMENT: return "Invalid argument";
+      case GB_BUFFER_TOO_SMALL: return "Output buffer too small";
+      case GB_NO_EULERIAN_PATH: return "Graph has no Eulerian path";
+      case GB_OUT_OF_MEMORY: return "Out of memory";
+      case GB_INTERNAL_ERROR: return "Internal error";
+    }
+    return "Unknown status";
+  }
+
+  gb_status gb_validate(const gb_csr_view *graph) {
+    gb_status status = __checkOffsets(graph);
+    if (status != GB_OK) return status;
+
+    uint64_t halfEdges = graph->vertex_count > 0 ? graph->offsets[graph->vertex_count] : 0;
+    for (uint64_t i = 0; i < halfEdges; i++) {
+      if (graph->neighbours[i] < 0 || graph->neighbours[i] >= graph->vertex_count) return GB_INVALID_ARGUMENT;
+    }
+    return GB_OK;
+  }
+
+  gb_status gb_find_bridges(const gb_csr_view *graph, int32_t *pairs, size_t capacity, size_t *count) {
+    gb_status status = __checkOffsets(graph);
+    if (status != GB_OK) return status;
+    if (count == nullptr || (capacity > 0 && pairs == nullptr)) return GB_INVALID_ARGUMENT;
+
+    return __guard([&]() {
+      EdgeVector bridges = tarjanAllComponents(__view(graph));
+      *count = bridges.size();
+      if (bridges.size() > capacity) return GB_BUFFER_TOO_SMALL;
+
+      for (size_t i = 0; i < bridges.size(); i++) {
+        pairs[2 * i] = bridges[i].first;
+        pairs[2 * i + 1] = bridges[i].second;
+      }
+      return GB_OK;
+    });
+  }
+
+  gb_status gb_find_eulerian_path(const gb_csr_view *graph, int32_t *path, size_t capacity, size_t *length) {
+    gb_status status = __checkOffsets(graph);
+    if (status != GB_OK) return status;
+    if (length == nullptr || (capacity > 0 && path == nullptr)) return GB_INVALID_ARGUMENT;
+
+    *length = 0;
+    if (graph->vertex_count == 0) return GB_OK;
+
+    CsrView view = __view(graph);
+    const size_t required = view.getHalfEdgeQuantity() / 2 + 1;
+    *length = required;
+    if (required > capacity) {
+      // Checked before the search, the degree parity is cheap and answers most "no path" cases
+      return canHaveEulerianPath(view).first ? GB_BUFFER_TOO_SMALL : GB_NO_EULERIAN_PATH;
+    }
+
+    return __guard([&]() {
+      vector<int> vertices = findEulerianPathHierholzer(view);
+      if (vertices.empty()) {
+        *length = 0;
+        return GB_NO_EULERIAN_PATH;
+      }
+      std::copy(vertices.begin(), vertices.end(), path);
+      return GB_OK;
+    });
+  }
+
+  gb_status gb_two_edge_components(const gb_csr_view *graph, int32_t *labels, size_t capacity, int32_t *component_count) {
+    gb_status status = __checkOffsets(graph);
+    if (status != GB_OK) return status;
+    if (capacity < static_cast<size_t>(graph->vertex_count)) return GB_BUFFER_TOO_SMALL;
+    if (graph->vertex_count > 0 && labels == nullptr) return GB_INVALID_ARGUMENT;
+
+    return __guard([&]() {
+      CsrView view = __view(graph);
+      int32_t quantity = labelTwoEdgeComponents(view, tarjanAllComponents(view), labels);
+      if (component_count != nullptr) *component_count = quantity;
+      return GB_OK;
+    });
+  }
+}
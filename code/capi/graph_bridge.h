@@ -0,0 +1,107 @@
+#ifndef GRAPH_BRIDGE_H
+#define GRAPH_BRIDGE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/**
+ * @brief Stable C interface of the graph-bridge engines (libgraphbridge)
+ *
+ * Graphs are passed as CSR arrays owned by the caller and read in place, nothing is
+ * copied: neighbours of v are neighbours[offsets[v] ... offsets[v+1]-1]. Every edge (u,v)
+ * must appear on both lists (twice on u's list for a self-loop). Lists do not need to be
+ * sorted, but sorted lists make the Eulerian path faster.
+ *
+ * Results are written into buffers provided by the caller. Every function returns a
+ * gb_status; on GB_BUFFER_TOO_SMALL the required size is still written to the count
+ * argument, so callers can size the buffer and call again. gb_two_edge_components is the
+ * exception: it always needs vertex_count labels, which the caller already knows, and
+ * writes nothing when the buffer is smaller.
+ *
+ * Functions only read the view and keep no state between calls, so they may be called
+ * from several threads at once.
+ */
+
+#if defined(_WIN32)
+#  if defined(GRAPH_BRIDGE_BUILD)
+#    define GB_API __declspec(dllexport)
+#  else
+#    define GB_API
+#  endif
+#else
+#  define GB_API __attribute__((visibility("default")))
+#endif
+
+#define GB_API_VERSION 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum gb_status {
+    GB_OK = 0,
+    GB_INVALID_ARGUMENT,    /* Null pointers, negative vertex count or malformed arrays */
+    GB_BUFFER_TOO_SMALL,    /* The required size was written to the count argument (vertex_count for labels) */
+    GB_NO_EULERIAN_PATH,    /* More than two odd vertices, or edges out of reach */
+    GB_OUT_OF_MEMORY,
+    GB_INTERNAL_ERROR
+} gb_status;
+
+/** @brief Borrowed CSR arrays, see the description above */
+typedef struct gb_csr_view {
+    int32_t vertex_count;
+    const uint64_t *offsets;     /* [vertex_count + 1], offsets[0] is 0 */
+    const int32_t *neighbours;   /* [offsets[vertex_count]] */
+} gb_csr_view;
+
+
+/** @brief GB_API_VERSION the library was built with */
+GB_API int gb_api_version(void);
+
+/** @brief Static description of a status, never null */
+GB_API const char *gb_status_string(gb_status status);
+
+/**
+ * @brief Checks the view: monotone offsets, an even half-edge count and neighbours on range
+ *
+ * The other functions run the same O(V) checks on the offsets, this one also scans the
+ * neighbours (O(V + E)), which is worth it once for arrays from an untrusted source.
+ */
+GB_API gb_status gb_validate(const gb_csr_view *graph);
+
+/**
+ * @brief Bridges of every connected component
+ *
+ * @param pairs Output, 2 * capacity values: bridge i is (pairs[2i], pairs[2i+1]), with
+ *        pairs[2i] < pairs[2i+1], sorted
+ * @param capacity Bridges that fit in pairs
+ * @param count Output, bridges found
+ */
+GB_API gb_status gb_find_bridges(const gb_csr_view *graph, int32_t *pairs, size_t capacity, size_t *count);
+
+/**
+ * @brief Eulerian path (or circuit) with Hierholzer's algorithm
+ *
+ * @param path Output, vertices of the path, edge count + 1 of them
+ * @param capacity Vertices that fit in path
+ * @param length Output, vertices on the path. 0 for a graph without vertices
+ */
+GB_API gb_status gb_find_eulerian_path(const gb_csr_view *graph, int32_t *path, size_t capacity, size_t *length);
+
+/**
+ * @brief 2-edge-connected component of every vertex (connected components without the bridges)
+ *
+ * @param labels Output, vertex_count values on range [0 ... component_count-1]
+ * @param capacity Values that fit in labels. Below vertex_count the call returns
+ *        GB_BUFFER_TOO_SMALL and reports no size, the required one is always vertex_count
+ * @param component_count Output, may be null. Not written on errors
+ */
+GB_API gb_status gb_two_edge_components(const gb_csr_view *graph, int32_t *labels, size_t capacity, int32_t *component_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif  /* GRAPH_BRIDGE_H */
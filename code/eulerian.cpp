@@ -1,4 +1,7 @@
 #include "eulerian.hpp"
+#include "trace.hpp"
+
+#include <algorithm>
 
 
 /*
@@ -6,11 +9,15 @@
 @params graph the graph to be analyzed
 @return pair of (bool, int) where bool indicates if Eulerian path exists, and int is the starting vertex (or -1 if no path)
 */
-pair<bool, int> canHaveEulerianPath(Graph& graph) {
-  int odd = 0;
-  int start = -1;
-  for (int i = 0; i < graph.getVertexQuantity(); i++) {
-    if (graph.adj[i].size() % 2 != 0) {
+template <typename G>
+pair<bool, typename G::Vertex> canHaveEulerianPath(const G& graph) {
+  using Vertex = typename G::Vertex;
+  static_assert(!G::TraitsType::directed, "Degree parity only applies to undirected graphs");
+
+  Vertex odd = 0;
+  Vertex start = -1;
+  for (Vertex i = 0; i < graph.getVertexQuantity(); i++) {
+    if (graph.getEdgeQuantity(i) % 2 != 0) {
       odd++;
       if (start == -1) {
         start = i;
@@ -36,7 +43,8 @@ pair<bool, int> canHaveEulerianPath(Graph& graph) {
 @params bridges the vector of bridges
 @return true if the edge is a bridge, false otherwise
 */
-bool isEdgeBridge(int u, int v, const EdgeVector &bridges) {
+template <typename Vertex>
+bool isEdgeBridge(Vertex u, Vertex v, const BasicEdgeVector<Vertex> &bridges) {
   for (const auto &bridge : bridges) {
     if ((bridge.first == u && bridge.second == v) ||
         (bridge.first == v && bridge.second == u)) {
@@ -52,33 +60,44 @@ bool isEdgeBridge(int u, int v, const EdgeVector &bridges) {
 @param graph The graph to be analyzed
 @return A list of vertices representing the Eulerian path, or an empty list if no path exists
 */
-vector<int> findEulerianPathTarjan(Graph &graph) {
+template <typename Traits>
+vector<typename Traits::Vertex> findEulerianPathTarjan(BasicGraph<Traits> &graph) {
+  algostats::NoStats stats;
+  return findEulerianPathTarjan(graph, stats);
+}
 
-  vector<int> path;
-  pair<bool, int> result = canHaveEulerianPath(graph);
+template <typename Traits, typename Stats>
+vector<typename Traits::Vertex> findEulerianPathTarjan(BasicGraph<Traits> &graph, Stats& stats) {
+  using Vertex = typename Traits::Vertex;
+  TRACE_SPAN("fleury.tarjan");
+
+  vector<Vertex> path;
+  pair<bool, Vertex> result = canHaveEulerianPath(graph);
   bool hasPath = result.first;
-  int startVertex = result.second;
+  Vertex startVertex = result.second;
   
   if (!hasPath) {
     return path; // Return empty path if no Eulerian path exists
   }
 
 
-  stack<int> stack;
+  stack<Vertex> stack;
   stack.push(startVertex);
 
   while (!stack.empty()) {
-    int u = stack.top();
+    Vertex u = stack.top();
 
     if (graph.adj[u].size() == 0) {
       path.push_back(u);
       stack.pop();
     } else {
-      EdgeVector bridges = tarjan(graph);
+      TRACE_SPAN("fleury.step");
+      stats.oracleCall();
+      BasicEdgeVector<Vertex> bridges = tarjan(graph, stats);
 
-      int chosen = -1;
+      Vertex chosen = -1;
 
-      for (int v : graph.adj[u]) {
+      for (Vertex v : graph.adj[u]) {
         if (bridges.empty() || !isEdgeBridge(u, v, bridges)) {
           chosen = v;
           break;
@@ -96,32 +115,44 @@ vector<int> findEulerianPathTarjan(Graph &graph) {
   return path;
 }
 
-vector<int> findEulerianPathNaive(Graph &graph) {
-  vector<int> path;
-  pair<bool, int> result = canHaveEulerianPath(graph);
+template <typename Traits>
+vector<typename Traits::Vertex> findEulerianPathNaive(BasicGraph<Traits> &graph) {
+  algostats::NoStats stats;
+  return findEulerianPathNaive(graph, stats);
+}
+
+template <typename Traits, typename Stats>
+vector<typename Traits::Vertex> findEulerianPathNaive(BasicGraph<Traits> &graph, Stats& stats) {
+  using Vertex = typename Traits::Vertex;
+  TRACE_SPAN("fleury.naive");
+
+  vector<Vertex> path;
+  pair<bool, Vertex> result = canHaveEulerianPath(graph);
   bool hasPath = result.first;
-  int startVertex = result.second;
+  Vertex startVertex = result.second;
   
   if (!hasPath) {
     return path; // Return empty path if no Eulerian path exists
   }
 
 
-  stack<int> stack;
+  stack<Vertex> stack;
   stack.push(startVertex);
 
   while (!stack.empty()) {
-    int u = stack.top();
+    Vertex u = stack.top();
 
     if (graph.adj[u].size() == 0) {
       path.push_back(u);
       stack.pop();
     } else {
-      EdgeVector bridges = executeNaive(graph);
+      TRACE_SPAN("fleury.step");
+      stats.oracleCall();
+      BasicEdgeVector<Vertex> bridges = executeNaive(graph, stats);
 
-      int chosen = -1;
+      Vertex chosen = -1;
 
-      for (int v : graph.adj[u]) {
+      for (Vertex v : graph.adj[u]) {
         if (bridges.empty() || !isEdgeBridge(u, v, bridges)) {
           chosen = v;
           break;
@@ -138,3 +169,208 @@ vector<int> findEulerianPathNaive(Graph &graph) {
 
   return path;
 }
+
+
+/*
+@brief pairs every half-edge of the compressed graph with its twin, decoding each list once
+Lists are sorted and symmetric, so the half-edges u -> w with u < w, visited in increasing u,
+meet the prefix of the list of w (values below w) in the same order. A self-loop is a pair of
+consecutive half-edges u -> u
+@params graph the compressed graph
+@return for each global half-edge u -> w, the position of its twin inside the list of w, or -1 if none
+*/
+vector<int> buildTwinIndex(const CompressedGraph &graph) {
+  int n = graph.getVertexQuantity();
+  vector<int> twin(graph.getHalfEdgeQuantity(), -1);
+  vector<int> backCursor(n, 0);  // Next unpaired entry below w on the list of w
+
+  for (int u = 0; u < n; u++) {
+    uint64_t index = graph.firstHalfEdge(u);
+    long long pendingLoop = -1;
+    for (int w : graph.neighbours(u)) {
+      if (w == u) {
+        if (pendingLoop >= 0) {
+          twin[index] = static_cast<int>(pendingLoop - static_cast<long long>(graph.firstHalfEdge(u)));
+          twin[pendingLoop] = static_cast<int>(index - graph.firstHalfEdge(u));
+          pendingLoop = -1;
+        } else {
+          pendingLoop = static_cast<long long>(index);
+        }
+      } else if (w > u && backCursor[w] < graph.getEdgeQuantity(w)) {
+        int slot = backCursor[w]++;
+        twin[index] = slot;
+        twin[graph.firstHalfEdge(w) + slot] = static_cast<int>(index - graph.firstHalfEdge(u));
+      }
+      index++;
+    }
+  }
+  return twin;
+}
+
+vector<int> findEulerianPathHierholzer(const CompressedGraph &graph) {
+  TRACE_SPAN("hierholzer");
+  vector<int> path;
+  pair<bool, int> result = canHaveEulerianPath(graph);
+  bool hasPath = result.first;
+  int startVertex = result.second;
+
+  if (!hasPath || graph.getVertexQuantity() == 0) {
+    return path;
+  }
+
+  int n = graph.getVertexQuantity();
+  // A circuit may start anywhere, but vertex 0 can be isolated
+  while (startVertex < n - 1 && graph.getEdgeQuantity(startVertex) == 0) {
+    startVertex++;
+  }
+
+  // Twins are found once on a decoding pass (4 bytes per half-edge), instead of decoding
+  // the list of v again for every edge u -> v
+  vector<int> twin = buildTwinIndex(graph);
+  vector<bool> used(graph.getHalfEdgeQuantity(), false);
+
+  // Cursor per vertex: decoding state is kept, so the walk decodes every list only once
+  vector<CompressedGraph::NeighbourIterator> cursor(n);
+  vector<uint64_t> position(n);
+  for (int v = 0; v < n; v++) {
+    cursor[v] = graph.neighbours(v).begin();
+    position[v] = graph.firstHalfEdge(v);
+  }
+  const CompressedGraph::NeighbourIterator end;
+  path.reserve(graph.getHalfEdgeQuantity() / 2 + 1);
+
+  stack<int> stack;
+  stack.push(startVertex);
+
+  while (!stack.empty()) {
+    int u = stack.top();
+
+    // Skip half-edges already consumed from the other side
+    while (cursor[u] != end && used[position[u]]) {
+      ++cursor[u];
+      position[u]++;
+    }
+
+    if (cursor[u] == end) {
+      path.push_back(u);
+      stack.pop();
+    } else {
+      int v = *cursor[u];
+      used[position[u]] = true;
+      if (twin[position[u]] >= 0) {
+        used[graph.firstHalfEdge(v) + twin[position[u]]] = true;
+      }
+      ++cursor[u];
+      position[u]++;
+
+      stack.push(v);
+    }
+  }
+
+  // Parity holds but some edges sit on another component
+  if (path.size() != graph.getHalfEdgeQuantity() / 2 + 1) {
+    path.clear();
+  }
+  return path;
+}
+
+
+/*
+@brief finds an unused half-edge v -> u, the twin of an used half-edge u -> v, on CSR arrays
+@params graph the CSR view
+@params v the vertex whose list is scanned
+@params u the neighbour being searched
+@params sorted whether every list is sorted, which allows a binary search
+@params used bitset of used half-edges
+@return slot of the first unused half-edge v -> u, or -1 if none is left
+*/
+long long findTwinHalfEdge(const CsrView &graph, int v, int u, bool sorted, const vector<bool> &used) {
+  const int *first = graph.neighbourList + graph.offsets[v];
+  const int *last = graph.neighbourList + graph.offsets[v + 1];
+  for (const int *w = sorted ? std::lower_bound(first, last, u) : first; w != last; w++) {
+    if (sorted && *w != u) break;
+    if (*w == u && !used[w - graph.neighbourList]) {
+      return static_cast<long long>(w - graph.neighbourList);
+    }
+  }
+  return -1;
+}
+
+vector<int> findEulerianPathHierholzer(const CsrView &graph) {
+  TRACE_SPAN("hierholzer");
+  vector<int> path;
+  pair<bool, int> result = canHaveEulerianPath(graph);
+  if (!result.first || graph.getVertexQuantity() == 0) {
+    return path;
+  }
+
+  int n = graph.getVertexQuantity();
+  int startVertex = result.second;
+  // A circuit may start anywhere, but vertex 0 can be isolated
+  while (startVertex < n - 1 && graph.getEdgeQuantity(startVertex) == 0) {
+    startVertex++;
+  }
+
+  bool sorted = true;
+  for (int v = 0; v < n && sorted; v++) {
+    CsrView::NeighbourSpan list = graph.neighbours(v);
+    sorted = std::is_sorted(list.begin(), list.end());
+  }
+
+  vector<bool> used(graph.getHalfEdgeQuantity(), false);
+  vector<uint64_t> position(graph.offsets, graph.offsets + n);  // Next slot to try on each list
+  path.reserve(graph.getHalfEdgeQuantity() / 2 + 1);
+
+  stack<int> stack;
+  stack.push(startVertex);
+
+  while (!stack.empty()) {
+    int u = stack.top();
+
+    // Skip half-edges already consumed from the other side
+    while (position[u] < graph.offsets[u + 1] && used[position[u]]) {
+      position[u]++;
+    }
+
+    if (position[u] == graph.offsets[u + 1]) {
+      path.push_back(u);
+      stack.pop();
+    } else {
+      int v = graph.neighbourList[position[u]];
+      used[position[u]] = true;
+      position[u]++;
+
+      long long twin = findTwinHalfEdge(graph, v, u, sorted, used);
+      if (twin >= 0) {
+        used[twin] = true;
+      }
+
+      stack.push(v);
+    }
+  }
+
+  // Parity holds but some edges sit on another component
+  if (path.size() != graph.getHalfEdgeQuantity() / 2 + 1) {
+    path.clear();
+  }
+  return path;
+}
+
+
+#define INSTANTIATE_EULERIAN(Traits) \
+    template pair<bool, typename Traits::Vertex> canHaveEulerianPath<BasicGraph<Traits>>(const BasicGraph<Traits>& graph); \
+    template vector<typename Traits::Vertex> findEulerianPathTarjan<Traits>(BasicGraph<Traits>& graph); \
+    template vector<typename Traits::Vertex> findEulerianPathNaive<Traits>(BasicGraph<Traits>& graph); \
+    template vector<typename Traits::Vertex> findEulerianPathTarjan<Traits, algostats::NoStats>(BasicGraph<Traits>& graph, algostats::NoStats& stats); \
+    template vector<typename Traits::Vertex> findEulerianPathNaive<Traits, algostats::NoStats>(BasicGraph<Traits>& graph, algostats::NoStats& stats); \
+    template vector<typename Traits::Vertex> findEulerianPathTarjan<Traits, algostats::CountingStats>(BasicGraph<Traits>& graph, algostats::CountingStats& stats); \
+    template vector<typename Traits::Vertex> findEulerianPathNaive<Traits, algostats::CountingStats>(BasicGraph<Traits>& graph, algostats::CountingStats& stats);
+
+INSTANTIATE_EULERIAN(DefaultGraphTraits)
+INSTANTIATE_EULERIAN(SmallGraphTraits)
+INSTANTIATE_EULERIAN(WideGraphTraits)
+INSTANTIATE_EULERIAN(SimpleGraphTraits)
+
+template pair<bool, int> canHaveEulerianPath<CompressedGraph>(const CompressedGraph& graph);
+template pair<bool, int> canHaveEulerianPath<CsrGraph>(const CsrGraph& graph);
+template pair<bool, int> canHaveEulerianPath<CsrView>(const CsrView& graph);
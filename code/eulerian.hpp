@@ -8,20 +8,52 @@
 #include "naive.hpp"
 #include "graph_reader.hpp"
 #include "graph.hpp"
+#include "compressed_graph.hpp"
 using namespace std;
 
 /*
 @brief this method runs the graph and returns if there's a possibility of existence of an eulerian path
+Works for every BasicGraph instantiation, CsrGraph, CsrView and CompressedGraph
 */
-pair<bool, int> canHaveEulerianPath(Graph& graph);
+template <typename G>
+pair<bool, typename G::Vertex> canHaveEulerianPath(const G& graph);
 
 /*
 @brief Finds an Eulerian path in the graph using Fleury's algorithm
 @param graph The graph to be analyzed
 @return A list of vertices representing the Eulerian path, or an empty list if no path exists
 */
-vector<int> findEulerianPathTarjan(Graph& graph);
+template <typename Traits>
+vector<typename Traits::Vertex> findEulerianPathTarjan(BasicGraph<Traits>& graph);
 
-vector<int> findEulerianPathNaive(Graph& graph);
+template <typename Traits>
+vector<typename Traits::Vertex> findEulerianPathNaive(BasicGraph<Traits>& graph);
+
+/*
+@brief Fleury's algorithm reporting to a statistics policy (see algorithm_stats.hpp)
+Each step asks the bridge oracle (tarjan or executeNaive) once, counted as an oracle call
+*/
+template <typename Traits, typename Stats>
+vector<typename Traits::Vertex> findEulerianPathTarjan(BasicGraph<Traits>& graph, Stats& stats);
+
+template <typename Traits, typename Stats>
+vector<typename Traits::Vertex> findEulerianPathNaive(BasicGraph<Traits>& graph, Stats& stats);
+
+/*
+@brief Finds an Eulerian path with Hierholzer's algorithm, directly over the compressed lists
+Twins of the half-edges are paired on one decoding pass beforehand, so the run is linear
+on the quantity of edges, at the cost of 4 extra bytes per half-edge
+@param graph The graph to be analyzed, it is not modified (used edges are marked on a bitset)
+@return A list of vertices representing the Eulerian path, or an empty list if no path exists
+*/
+vector<int> findEulerianPathHierholzer(const CompressedGraph& graph);
+
+/*
+@brief Hierholzer's algorithm over CSR arrays read in place, half-edges are indexed by their slot
+Lists do not need to be sorted, sorted ones find twins with a binary search
+@param graph The graph to be analyzed, it is not modified
+@return A list of vertices representing the Eulerian path, or an empty list if no path exists
+*/
+vector<int> findEulerianPathHierholzer(const CsrView& graph);
 
 #endif // EULERIAN_PATH_H
\ No newline at end of file
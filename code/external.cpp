@@ -0,0 +1,312 @@
+#include "external.hpp"
+#include "streaming.hpp"
+#include "trace.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+
+namespace external {
+
+    //---- BlockCache ----//
+
+    BlockCache::BlockCache(size_t cacheBytes, size_t blockBytes, unsigned readAhead)
+        : blockBytes(std::max<size_t>((blockBytes + 3) / 4 * 4, 4)), readAhead(std::max(readAhead, 1u)) {
+        capacity = std::max<size_t>(cacheBytes / this->blockBytes, this->readAhead + 1);
+    }
+
+    BlockCache::~BlockCache() {
+        if (fd >= 0) ::close(fd);
+    }
+
+    Response<void> BlockCache::open(const std::string& filename) {
+        fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return Response<void>(ErrorCode::OPEN_FAILED, "Error: Could not open input file for reading");
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0) return Response<void>(ErrorCode::READ_FAILED, "Error: Could not stat input file");
+        fileBytes = static_cast<uint64_t>(info.st_size);
+        return Response<void>();
+    }
+
+    std::vector<char> BlockCache::takeBuffer() {
+        if (blocks.size() < capacity) return std::vector<char>(blockBytes);
+
+        // Least recently used block gives its buffer away
+        uint64_t victim = recency.back();
+        recency.pop_back();
+        auto it = blocks.find(victim);
+        std::vector<char> buffer = std::move(it->second.data);
+        blocks.erase(it);
+        return buffer;
+    }
+
+    const char* BlockCache::block(uint64_t index) {
+        auto found = blocks.find(index);
+        if (found != blocks.end()) {
+            hits++;
+            recency.splice(recency.begin(), recency, found->second.position);
+            return found->second.data.data();
+        }
+        misses++;
+
+        // Read-ahead: the missing run starting at index, in one call
+        const uint64_t first = index * blockBytes;
+        if (first >= fileBytes) return nullptr;
+        const uint64_t lastBlock = (fileBytes - 1) / blockBytes;
+        // Only misses that continue the previous run read ahead, random ones read one block
+        const unsigned run = index == nextSequential ? readAhead : 1;
+        unsigned count = 1;
+        while (count < run && index + count <= lastBlock && !resident(index + count)) count++;
+        nextSequential = index + count;
+
+        std::vector<std::vector<char>> buffers(count);
+        std::vector<struct iovec> parts(count);
+        for (unsigned i = 0; i < count; i++) {
+            buffers[i] = takeBuffer();
+            parts[i].iov_base = buffers[i].data();
+            parts[i].iov_len = blockBytes;
+        }
+
+        const uint64_t expected = std::min<uint64_t>(uint64_t(count) * blockBytes, fileBytes - first);
+        ssize_t got;
+        do {
+            got = ::preadv(fd, parts.data(), static_cast<int>(count), static_cast<off_t>(first));
+        } while (got < 0 && errno == EINTR);
+        if (got < 0) return nullptr;
+        reads++;
+
+        // Short reads are rare on regular files, the rest is read block by block
+        uint64_t done = static_cast<uint64_t>(got);
+        while (done < expected) {
+            unsigned i = static_cast<unsigned>(done / blockBytes);
+            uint64_t offset = done % blockBytes;
+            uint64_t wanted = std::min<uint64_t>(blockBytes - offset, expected - done);
+            ssize_t more = ::pread(fd, buffers[i].data() + offset, wanted, static_cast<off_t>(first + done));
+            if (more < 0 && errno == EINTR) continue;
+            if (more <= 0) return nullptr;
+            reads++;
+            done += static_cast<uint64_t>(more);
+        }
+        bytesRead += expected;
+
+        // Inserted backwards, so the requested block ends up as the most recent one
+        for (unsigned i = count; i-- > 0;) {
+            recency.push_front(index + i);
+            blocks[index + i] = Block{std::move(buffers[i]), recency.begin()};
+        }
+
+        adviseSequential(first + uint64_t(count) * blockBytes, uint64_t(readAhead) * blockBytes);
+        return blocks[index].data.data();
+    }
+
+    void BlockCache::adviseSequential(uint64_t offset, uint64_t length) const {
+#ifdef POSIX_FADV_WILLNEED
+        if (offset < fileBytes) ::posix_fadvise(fd, static_cast<off_t>(offset), static_cast<off_t>(length), POSIX_FADV_WILLNEED);
+#else
+        (void) offset;
+        (void) length;
+#endif
+    }
+
+
+    //---- Métodos auxiliares ----//
+
+    /**
+     * @brief Sequential pass over the lengths: start[v] is the offset of the length header of v
+     *
+     * start[V] is the file size. Long lists are jumped over, only the chunks holding length
+     * headers are read.
+     */
+    Response<int> __indexLists(const BlockCache& cache, std::vector<uint64_t>& start, uint64_t& bytesRead) {
+        const size_t CHUNK = size_t(4) << 20;
+        std::vector<char> chunk(CHUNK);
+        uint64_t chunkBegin = 0, chunkEnd = 0;
+        bytesRead = 0;
+
+        auto readInt = [&](uint64_t position, int& value) {
+            if (position + sizeof(int) > cache.size()) return false;
+            if (position < chunkBegin || position + sizeof(int) > chunkEnd) {
+                uint64_t length = std::min<uint64_t>(CHUNK, cache.size() - position);
+                ssize_t got;
+                do {
+                    got = ::pread(cache.descriptor(), chunk.data(), length, static_cast<off_t>(position));
+                } while (got < 0 && errno == EINTR);
+                if (got < static_cast<ssize_t>(sizeof(int))) return false;
+                chunkBegin = position;
+                chunkEnd = position + static_cast<uint64_t>(got);
+                bytesRead += static_cast<uint64_t>(got);
+            }
+            std::memcpy(&value, chunk.data() + (position - chunkBegin), sizeof(int));
+            return true;
+        };
+
+        cache.adviseSequential(0, cache.size());
+        int n = 0;
+        if (!readInt(0, n) || n < 0) return Response<int>(ErrorCode::INVALID_FORMAT, "Error: Invalid vertex quantity on input file");
+
+        start.resize(static_cast<size_t>(n) + 1);
+        uint64_t position = sizeof(int);
+        for (int v = 0; v < n; v++) {
+            int length;
+            if (!readInt(position, length) || length < 0) return Response<int>(ErrorCode::READ_FAILED, "Error: Corrupted adjacency list on input file");
+            start[v] = position;
+            position += sizeof(int) * (1 + static_cast<uint64_t>(length));
+        }
+        if (position != cache.size()) return Response<int>(ErrorCode::INVALID_FORMAT, "Error: Input file size does not match its lists");
+        start[n] = position;
+        return Response<int>(std::move(n));
+    }
+
+
+    /// @brief One sequential pass through a BridgeCertificate, Tarjan then runs on it in memory
+    Response<EdgeVector> __findBridgesByCertificate(const std::string& filename, uint64_t fileBytes, const ExternalOptions& options,
+                                                    ExternalStats *stats) {
+        std::vector<char> ioBuffer;
+        ioBuffer.reserve(std::min<size_t>(std::max<size_t>(options.cacheBytes, options.blockBytes), size_t(4) << 20));
+
+        streaming::StreamingStats streamed;
+        Response<EdgeVector> bridges = streaming::findBridgesFromFile(filename, ioBuffer, &streamed);
+        if (!bridges.isOk()) return bridges;
+        if (streamed.bytesRead != fileBytes) {
+            return Response<EdgeVector>(ErrorCode::INVALID_FORMAT, "Error: Input file size does not match its lists");
+        }
+
+        if (stats != nullptr) {
+            *stats = ExternalStats();
+            stats->vertices = streamed.vertices;
+            stats->edges = (fileBytes - sizeof(int) * (1 + static_cast<uint64_t>(streamed.vertices))) / sizeof(int) / 2;
+            stats->fileBytes = fileBytes;
+            stats->bytesRead = streamed.bytesRead;
+            stats->passes = fileBytes > 0 ? static_cast<double>(streamed.bytesRead) / fileBytes : 0;
+            stats->certificate = true;
+        }
+        return bridges;
+    }
+
+
+    //---- Métodos públicos ----//
+
+    Response<EdgeVector> findBridgesExternal(const std::string& filename, const ExternalOptions& options, ExternalStats *stats) {
+        TRACE_SPAN("external");
+        BlockCache cache(options.cacheBytes, options.blockBytes, options.readAhead);
+        Response<void> opened = cache.open(filename);
+        if (!opened.isOk()) return Response<EdgeVector>(opened.code, std::move(opened.message));
+
+        // Without locality the DFS rereads the file once per few blocks it evicts, the
+        // certificate bounds the work to one pass whatever the ids
+        if (options.certificateWhenLarger && cache.size() > options.cacheBytes) {
+            return __findBridgesByCertificate(filename, cache.size(), options, stats);
+        }
+
+        std::vector<uint64_t> start;
+        uint64_t indexBytes = 0;
+        Response<int> indexed = __indexLists(cache, start, indexBytes);
+        if (!indexed.isOk()) return Response<EdgeVector>(indexed.code, std::move(indexed.message));
+        const int n = indexed.value;
+        const uint64_t B = cache.getBlockBytes();
+
+        // Vertex state, the only per-vertex memory besides the index
+        std::vector<int> tin(n, -1), low(n), parent(n, -1);
+        std::vector<uint64_t> cursor(n);
+        std::vector<bool> skippedParent(n, false);
+        for (int v = 0; v < n; v++) cursor[v] = start[v] + sizeof(int);
+
+        auto listCached = [&](int v) {
+            uint64_t first = start[v] + sizeof(int);
+            return first == start[v + 1] || cache.resident(first / B);
+        };
+        auto readError = []() { return Response<EdgeVector>(ErrorCode::READ_FAILED, "Error: Could not read adjacency block"); };
+        auto rangeError = []() { return Response<EdgeVector>(ErrorCode::INVALID_FORMAT, "Error: Neighbour out of range on input file"); };
+
+        EdgeVector bridges;
+        std::vector<int> stack;
+        int time = 0;
+
+        for (int root = 0; root < n; root++) {
+            if (tin[root] != -1) continue;
+            tin[root] = low[root] = time++;
+            stack.push_back(root);
+
+            while (!stack.empty()) {
+                int v = stack.back();
+                uint64_t c = cursor[v];
+                const uint64_t end = start[v + 1];
+                int next = -1;
+
+                // Consumes the prefix of the list that needs no descent (parent, back edges)
+                while (c < end && next == -1) {
+                    const char *data = cache.block(c / B);
+                    if (data == nullptr) return readError();
+                    const uint64_t blockEnd = std::min(end, (c / B + 1) * B);
+                    for (; c < blockEnd; c += sizeof(int)) {
+                        int w;
+                        std::memcpy(&w, data + c % B, sizeof(int));
+                        if (w < 0 || w >= n) return rangeError();
+
+                        // Multigraph: only the first half-edge back to the parent is the tree edge
+                        if (w == parent[v] && !skippedParent[v]) {
+                            skippedParent[v] = true;
+                        } else if (tin[w] != -1) {
+                            low[v] = std::min(low[v], tin[w]);
+                        } else {
+                            next = w;
+                            break;
+                        }
+                    }
+                }
+                cursor[v] = c;
+
+                if (next == -1) {
+                    stack.pop_back();
+                    int p = parent[v];
+                    if (p != -1) {
+                        low[p] = std::min(low[p], low[v]);
+                        if (low[v] > tin[p]) bridges.emplace_back(std::min(p, v), std::max(p, v));
+                    }
+                    continue;
+                }
+
+                // Any unvisited neighbour is a valid child: prefer one whose list is cached. The
+                // entries skipped here are scanned again later, and a visited child only lowers
+                // low[v] to its own tin, which is above tin[v]
+                if (options.localityWindow > 0 && !listCached(next)) {
+                    const char *data = cache.block(c / B);
+                    if (data == nullptr) return readError();
+                    const uint64_t limit = std::min({end, (c / B + 1) * B, c + sizeof(int) * (1 + uint64_t(options.localityWindow))});
+                    for (uint64_t position = c + sizeof(int); position < limit; position += sizeof(int)) {
+                        int x;
+                        std::memcpy(&x, data + position % B, sizeof(int));
+                        if (x >= 0 && x < n && tin[x] == -1 && listCached(x)) {
+                            next = x;
+                            break;
+                        }
+                    }
+                }
+
+                parent[next] = v;
+                tin[next] = low[next] = time++;
+                stack.push_back(next);
+            }
+        }
+
+        if (stats != nullptr) {
+            stats->vertices = n;
+            stats->edges = (cache.size() - sizeof(int) * (1 + static_cast<uint64_t>(n))) / sizeof(int) / 2;
+            stats->fileBytes = cache.size();
+            stats->bytesRead = indexBytes + cache.getBytesRead();
+            stats->reads = cache.getReads();
+            stats->hits = cache.getHits();
+            stats->misses = cache.getMisses();
+            stats->passes = cache.size() > 0 ? static_cast<double>(stats->bytesRead) / cache.size() : 0;
+        }
+
+        std::sort(bridges.begin(), bridges.end());
+        return Response<EdgeVector>(std::move(bridges));
+    }
+}
@@ -0,0 +1,116 @@
+#ifndef EXTERNAL_HPP
+#define EXTERNAL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "tarjan.hpp"
+#include "response_struct.hpp"
+
+
+/**
+ * @brief Semi-external Tarjan: vertex state in memory, adjacency lists left on disk
+ *
+ * Works straight on a .graph file. One sequential pass indexes where each list starts,
+ * then the DFS keeps tin, low, parent and a list cursor per vertex (about 32 bytes per
+ * vertex) and reads the lists through a BlockCache of fixed size:
+ * - the DFS stack only holds vertices, each one resumes its list from its cursor, so memory
+ *   never depends on the quantity of edges
+ * - a miss that continues the previous one reads `readAhead` consecutive blocks with a single
+ *   call and hints the kernel about the following ones, so scans of neighbouring lists turn
+ *   into large sequential reads, while random misses read a single block
+ * - locality-aware child choice: a vertex may descend into any unvisited neighbour, so among
+ *   the next few entries of its list it prefers one whose list is already cached
+ *
+ * Locality is what keeps the reads close to one pass: graphs whose ids follow their structure
+ * (meshes, generated or reordered graphs) stay near it, while a graph with random ids reads a
+ * block per vertex, hundreds of passes once the file is several times the cache. So a file
+ * that does not fit in `cacheBytes` takes another route by default: one sequential pass feeds
+ * a streaming::BridgeCertificate (two spanning forests, O(V) memory like the DFS state) and
+ * Tarjan runs in memory on the certificate. `passes` reports the route actually taken.
+ *
+ * Same result as tarjanAllComponents() over the loaded graph.
+ */
+namespace external {
+
+    /// @brief LRU cache of fixed-size blocks of a file, read with pread
+    class BlockCache {
+      private:
+        struct Block {
+            std::vector<char> data;
+            std::list<uint64_t>::iterator position;  // On the recency list
+        };
+
+        int fd = -1;
+        uint64_t fileBytes = 0;
+        size_t blockBytes;
+        size_t capacity;        // Blocks kept at once
+        unsigned readAhead;
+        uint64_t nextSequential = 0;  // Block right after the last miss
+
+        std::unordered_map<uint64_t, Block> blocks;
+        std::list<uint64_t> recency;  // Most recent first
+
+        uint64_t hits = 0, misses = 0, reads = 0, bytesRead = 0;
+
+        std::vector<char> takeBuffer();
+
+      public:
+        /// @brief blockBytes is rounded up to a multiple of 4, so no entry straddles two blocks
+        BlockCache(size_t cacheBytes, size_t blockBytes, unsigned readAhead);
+        ~BlockCache();
+
+        BlockCache(const BlockCache&) = delete;
+        BlockCache& operator=(const BlockCache&) = delete;
+
+        Response<void> open(const std::string& filename);
+
+        uint64_t size() const { return fileBytes; }
+        size_t getBlockBytes() const { return blockBytes; }
+
+        /// @brief Block `index`, loaded when missing. Valid until the next load, null on read errors
+        const char* block(uint64_t index);
+
+        bool resident(uint64_t index) const { return blocks.count(index) > 0; }
+
+        /// @brief Hints the kernel that [offset, offset + length) is read sequentially next
+        void adviseSequential(uint64_t offset, uint64_t length) const;
+
+        int descriptor() const { return fd; }
+
+        uint64_t getHits() const { return hits; }
+        uint64_t getMisses() const { return misses; }
+        uint64_t getReads() const { return reads; }
+        uint64_t getBytesRead() const { return bytesRead; }
+    };
+
+
+    struct ExternalOptions {
+        size_t cacheBytes = size_t(64) << 20;  // Adjacency kept in memory
+        size_t blockBytes = size_t(64) << 10;
+        unsigned readAhead = 8;                 // Blocks read per sequential miss
+        unsigned localityWindow = 64;           // Entries looked ahead for a cached child, 0 disables it
+        bool certificateWhenLarger = true;      // Files larger than cacheBytes take one certificate pass, false forces the DFS
+    };
+
+    struct ExternalStats {
+        int vertices = 0;
+        uint64_t edges = 0;
+        uint64_t fileBytes = 0;
+        uint64_t bytesRead = 0;     // Index pass plus DFS reads
+        uint64_t reads = 0;         // Read calls of the DFS
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        double passes = 0;          // bytesRead / fileBytes
+        bool certificate = false;   // Answered by the certificate pass, reads and cache counters stay at zero
+    };
+
+    Response<EdgeVector> findBridgesExternal(const std::string& filename, const ExternalOptions& options = ExternalOptions(),
+                                             ExternalStats *stats = nullptr);
+}
+
+
+#endif  // EXTERNAL_HPP
@@ -0,0 +1,289 @@
+#include "compressed_graph.hpp"
+#include "graph.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <stack>
+#include <vector>
+
+// The SSSE3 decoder is compiled on every x86 build and chosen at runtime, no -mssse3 needed
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define COMPRESSED_GRAPH_SSSE3 1
+#include <tmmintrin.h>
+#endif
+
+
+//---- Stream VByte auxiliares ----//
+
+namespace {
+  // Extra bytes at the end of the byte array, so a quad can always be loaded with 16 bytes
+  const size_t PADDING = 16;
+
+  /**
+   * @brief Shuffle masks and data lengths for every control byte
+   *
+   * Lane i of a control byte holds (length - 1) of the i-th value on 2 bits.
+   * The mask moves the packed bytes of each value to its own 32 bit lane,
+   * filling the remaining bytes with zero (0x80 on pshufb).
+   */
+  struct QuadTable {
+    uint8_t mask[256][16];
+    uint8_t length[256];
+
+    QuadTable() {
+      for (int c = 0; c < 256; c++) {
+        int offset = 0;
+        for (int lane = 0; lane < 4; lane++) {
+          int len = ((c >> (2 * lane)) & 3) + 1;
+          for (int k = 0; k < 4; k++) {
+            mask[c][4 * lane + k] = k < len ? static_cast<uint8_t>(offset + k) : 0x80;
+          }
+          offset += len;
+        }
+        length[c] = static_cast<uint8_t>(offset);
+      }
+    }
+  };
+
+  const QuadTable& quadTable() {
+    static const QuadTable table;
+    return table;
+  }
+
+  inline int byteLength(uint32_t value) {
+    if (value < (1u << 8)) return 1;
+    if (value < (1u << 16)) return 2;
+    if (value < (1u << 24)) return 3;
+    return 4;
+  }
+
+  /// @brief Decodes the quad of control byte c into out, returns the last value (base of the next quad)
+  typedef uint32_t (*QuadDecoder)(uint8_t c, const uint8_t *data, uint32_t previous, uint32_t *out);
+
+  uint32_t decodeQuadScalar(uint8_t c, const uint8_t *data, uint32_t previous, uint32_t *out) {
+    uint32_t value = previous;
+    for (int lane = 0; lane < 4; lane++) {
+      int len = ((c >> (2 * lane)) & 3) + 1;
+      uint32_t delta = 0;
+      for (int k = 0; k < len; k++) {
+        delta |= static_cast<uint32_t>(data[k]) << (8 * k);
+      }
+      data += len;
+      value += delta;
+      out[lane] = value;
+    }
+    return value;
+  }
+
+#if defined(COMPRESSED_GRAPH_SSSE3)
+  __attribute__((target("ssse3")))
+  uint32_t decodeQuadSsse3(uint8_t c, const uint8_t *data, uint32_t previous, uint32_t *out) {
+    __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(quadTable().mask[c]));
+    __m128i values = _mm_shuffle_epi8(packed, shuffle);
+
+    // Prefix sum of the 4 deltas, plus the last value of the previous quad
+    values = _mm_add_epi32(values, _mm_slli_si128(values, 4));
+    values = _mm_add_epi32(values, _mm_slli_si128(values, 8));
+    values = _mm_add_epi32(values, _mm_set1_epi32(static_cast<int>(previous)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), values);
+    return out[3];
+  }
+#endif
+
+  bool cpuHasSsse3() {
+#if defined(COMPRESSED_GRAPH_SSSE3)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3");
+#else
+    return false;
+#endif
+  }
+
+  QuadDecoder bestDecoder() {
+#if defined(COMPRESSED_GRAPH_SSSE3)
+    if (cpuHasSsse3()) return decodeQuadSsse3;
+#endif
+    return decodeQuadScalar;
+  }
+
+  // Resolved on the first decoded quad, a relaxed load is a plain load on x86
+  uint32_t resolveDecoder(uint8_t c, const uint8_t *data, uint32_t previous, uint32_t *out);
+  std::atomic<QuadDecoder> activeDecoder(resolveDecoder);
+
+  uint32_t resolveDecoder(uint8_t c, const uint8_t *data, uint32_t previous, uint32_t *out) {
+    QuadDecoder expected = resolveDecoder;
+    activeDecoder.compare_exchange_strong(expected, bestDecoder());
+    return activeDecoder.load(std::memory_order_relaxed)(c, data, previous, out);
+  }
+}
+
+
+
+//---- NeighbourIterator ----//
+
+CompressedGraph::NeighbourIterator::NeighbourIterator()
+  : control(nullptr), data(nullptr), remaining(0), previous(0), buffer{0, 0, 0, 0}, index(0) {}
+
+CompressedGraph::NeighbourIterator::NeighbourIterator(const uint8_t *control, const uint8_t *data, uint64_t count)
+  : control(control), data(data), remaining(count), previous(0), buffer{0, 0, 0, 0}, index(0) {
+  if (remaining > 0) decodeQuad();
+}
+
+void CompressedGraph::NeighbourIterator::decodeQuad() {
+  uint8_t c = *control++;
+  // Only the last quad of a list can be partial, so lanes past the end are never used as base
+  previous = activeDecoder.load(std::memory_order_relaxed)(c, data, previous, buffer);
+  data += quadTable().length[c];
+  index = 0;
+}
+
+CompressedGraph::NeighbourIterator& CompressedGraph::NeighbourIterator::operator++() {
+  remaining--;
+  index++;
+  if (index == 4 && remaining > 0) {
+    decodeQuad();
+  }
+  return *this;
+}
+
+
+
+//---- CompressedGraph ----//
+
+bool CompressedGraph::setSimdDecoding(bool enabled) {
+  activeDecoder.store(enabled ? bestDecoder() : decodeQuadScalar);
+  return simdDecoding();
+}
+
+bool CompressedGraph::simdDecoding() {
+#if defined(COMPRESSED_GRAPH_SSSE3)
+  QuadDecoder decoder = activeDecoder.load();
+  return decoder == decodeQuadSsse3 || (decoder == resolveDecoder && cpuHasSsse3());
+#else
+  return false;
+#endif
+}
+
+CompressedGraph::CompressedGraph() : V(0) {
+  byteOffsets.assign(1, 0);
+  halfEdgeOffsets.assign(1, 0);
+  bytes.assign(PADDING, 0);
+}
+
+CompressedGraph CompressedGraph::compress(const Graph& graph) {
+  CompressedGraph compressed;
+  int n = graph.getVertexQuantity();
+
+  compressed.V = n;
+  compressed.byteOffsets.assign(n + 1, 0);
+  compressed.halfEdgeOffsets.assign(n + 1, 0);
+  compressed.bytes.clear();
+
+  std::vector<uint32_t> sorted;
+  for (int v = 0; v < n; v++) {
+    sorted.assign(graph.adj[v].begin(), graph.adj[v].end());
+    if (!graph.isCanonical()) {
+      std::sort(sorted.begin(), sorted.end());
+    }
+
+    size_t degree = sorted.size();
+    size_t controlStart = compressed.bytes.size();
+    size_t controlLength = (degree + 3) / 4;
+
+    compressed.byteOffsets[v] = controlStart;
+    compressed.halfEdgeOffsets[v + 1] = compressed.halfEdgeOffsets[v] + degree;
+    compressed.bytes.resize(controlStart + controlLength, 0);
+
+    uint32_t previous = 0;
+    for (size_t i = 0; i < degree; i++) {
+      uint32_t delta = sorted[i] - previous;
+      previous = sorted[i];
+
+      int len = byteLength(delta);
+      compressed.bytes[controlStart + i / 4] |= static_cast<uint8_t>((len - 1) << (2 * (i % 4)));
+      for (int k = 0; k < len; k++) {
+        compressed.bytes.push_back(static_cast<uint8_t>(delta >> (8 * k)));
+      }
+    }
+  }
+
+  compressed.byteOffsets[n] = compressed.bytes.size();
+  compressed.bytes.resize(compressed.bytes.size() + PADDING, 0);
+  compressed.bytes.shrink_to_fit();
+
+  return compressed;
+}
+
+Graph CompressedGraph::decompress() const {
+  Graph graph(V);
+  for (int v = 0; v < V; v++) {
+    for (int u : neighbours(v)) {
+      graph.pushEdge(v, u);
+    }
+  }
+  return graph;
+}
+
+CompressedGraph::NeighbourRange CompressedGraph::neighbours(int v) const {
+  uint64_t degree = halfEdgeOffsets[v + 1] - halfEdgeOffsets[v];
+  const uint8_t *control = bytes.data() + byteOffsets[v];
+  const uint8_t *data = control + (degree + 3) / 4;
+
+  return NeighbourRange{NeighbourIterator(control, data, degree), degree};
+}
+
+int CompressedGraph::getVertexQuantity() const {
+  return V;
+}
+
+int CompressedGraph::getEdgeQuantity(int v) const {
+  return static_cast<int>(halfEdgeOffsets[v + 1] - halfEdgeOffsets[v]);
+}
+
+int CompressedGraph::getTotalQuantityEdges() const {
+  return static_cast<int>(halfEdgeOffsets[V] / 2);
+}
+
+uint64_t CompressedGraph::getHalfEdgeQuantity() const {
+  return halfEdgeOffsets[V];
+}
+
+bool CompressedGraph::hasEdge(int u, int v) const {
+  for (int neighbour : neighbours(u)) {
+    if (neighbour >= v) return neighbour == v;
+  }
+  return false;
+}
+
+bool CompressedGraph::isConnected() const {
+  if (V == 0) return true;
+
+  std::vector<bool> visited(V, false);
+  std::stack<int> stack;
+  stack.push(0);
+  visited[0] = true;
+  int count = 1;
+
+  while (!stack.empty()) {
+    int u = stack.top();
+    stack.pop();
+
+    for (int v : neighbours(u)) {
+      if (!visited[v]) {
+        visited[v] = true;
+        count++;
+        stack.push(v);
+      }
+    }
+  }
+
+  return count == V;
+}
+
+size_t CompressedGraph::sizeInBytes() const {
+  return bytes.capacity() * sizeof(uint8_t)
+    + byteOffsets.capacity() * sizeof(uint64_t)
+    + halfEdgeOffsets.capacity() * sizeof(uint64_t);
+}
@@ -0,0 +1,118 @@
+#ifndef COMPRESSED_GRAPH_HPP
+#define COMPRESSED_GRAPH_HPP
+
+#include "graph.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <iterator>
+
+
+/**
+ * @brief Read-only graph with compressed adjacency lists
+ *
+ * Each neighbour list is sorted, delta encoded and packed with Stream VByte:
+ * for every group of 4 deltas a control byte stores the byte length (1..4) of each
+ * value, followed by the packed values. Control bytes of a vertex are stored before
+ * its data bytes on a single contiguous byte array.
+ *
+ * Per half-edge cost is usually 1-2 bytes (against ~24 bytes on the std::list layout),
+ * plus 16 bytes per vertex for the offsets.
+ *
+ * Lists are decoded lazily by NeighbourIterator, 4 values at a time, so traversals
+ * never decompress the whole graph. On x86 CPUs with SSSE3 (detected at runtime, no
+ * special flags needed) every group is decoded with a single shuffle.
+ */
+class CompressedGraph {
+  public:
+    using Vertex = int;
+    using TraitsType = DefaultGraphTraits;
+
+    /// @brief Forward iterator that decodes a neighbour list on the fly
+    class NeighbourIterator {
+      private:
+        const uint8_t *control;  // Next control byte
+        const uint8_t *data;     // Next data byte
+        uint64_t remaining;      // Values still to be returned (including buffered ones)
+        uint32_t previous;       // Last decoded value, base for the next delta
+        uint32_t buffer[4];      // Decoded quad
+        int index;               // Position inside buffer
+
+        void decodeQuad();
+
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = int;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const int*;
+        using reference = int;
+
+        NeighbourIterator();
+        NeighbourIterator(const uint8_t *control, const uint8_t *data, uint64_t count);
+
+        int operator*() const { return static_cast<int>(buffer[index]); }
+        NeighbourIterator& operator++();
+
+        /// @brief Only end-of-list comparisons are supported, by remaining count
+        bool operator==(const NeighbourIterator& other) const { return remaining == other.remaining; }
+        bool operator!=(const NeighbourIterator& other) const { return remaining != other.remaining; }
+    };
+
+    /// @brief Range returned by neighbours(), usable on range-for loops
+    struct NeighbourRange {
+        NeighbourIterator first;
+        size_t count;
+
+        NeighbourIterator begin() const { return first; }
+        NeighbourIterator end() const { return NeighbourIterator(); }
+        size_t size() const { return count; }
+    };
+
+
+    int V;  // Vertex quantity
+
+    CompressedGraph();
+
+    /// @brief Builds the compressed representation of the given graph
+    static CompressedGraph compress(const Graph& graph);
+
+    /// @brief Rebuilds a mutable graph, with sorted neighbour lists
+    Graph decompress() const;
+
+    NeighbourRange neighbours(int v) const;
+
+    /// @brief Global index of the first half-edge of v, half-edges of v are [first, first + degree)
+    uint64_t firstHalfEdge(int v) const { return halfEdgeOffsets[v]; }
+
+    int getVertexQuantity() const;
+
+    int getEdgeQuantity(int v) const;
+
+    int getTotalQuantityEdges() const;
+
+    uint64_t getHalfEdgeQuantity() const;
+
+    /// @brief Checks the existence of an edge between u and v, stops at the first value >= v
+    bool hasEdge(int u, int v) const;
+
+    /// @brief Verify if the graph is connected
+    bool isConnected() const;
+
+    /// @brief Memory used by the compressed arrays, in bytes
+    size_t sizeInBytes() const;
+
+    /// @brief Chooses the SSSE3 decoder (when the CPU has it) or the scalar one, returns whether SSSE3 is used
+    static bool setSimdDecoding(bool enabled);
+
+    /// @brief True when quads are decoded with SSSE3
+    static bool simdDecoding();
+
+  private:
+    std::vector<uint64_t> byteOffsets;      // [V + 1] start of each vertex on bytes
+    std::vector<uint64_t> halfEdgeOffsets;  // [V + 1] prefix sum of degrees
+    std::vector<uint8_t> bytes;             // Control and data bytes, padded for 16 byte loads
+};
+
+
+#endif  // COMPRESSED_GRAPH_HPP
@@ -0,0 +1,184 @@
+#include "csr_graph.hpp"
+#include "graph.hpp"
+#include "scheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+
+//---- Métodos auxiliares ----//
+
+namespace {
+  // Below this amount of pairs a single thread is faster than splitting the work
+  const size_t PARALLEL_THRESHOLD = 1 << 16;
+
+  unsigned threadCount(const csr::BuildOptions& options, size_t work) {
+    if (work < PARALLEL_THRESHOLD) return 1;
+    unsigned threads = options.threads != 0 ? options.threads : sched::threadCount();
+    return std::max(1u, threads);
+  }
+
+  /// @brief Runs fn(begin, end) over `threads` contiguous slices of [0, count), on the shared pool
+  template <typename F>
+  void forEachSlice(unsigned threads, size_t count, F fn) {
+    size_t slice = (count + threads - 1) / std::max(1u, threads);
+    sched::parallelFor(0, count, std::max<size_t>(slice, 1), fn);
+  }
+
+  /// @brief Splits vertices in ranges with roughly the same quantity of half-edges
+  std::vector<std::pair<int, int>> balancedRanges(const std::vector<uint64_t>& offsets, int n, unsigned threads) {
+    std::vector<std::pair<int, int>> ranges;
+    uint64_t target = offsets[n] / threads + 1;
+    int begin = 0;
+    for (int v = 0; v < n; v++) {
+      if (offsets[v + 1] - offsets[begin] >= target || v == n - 1) {
+        ranges.push_back({begin, v + 1});
+        begin = v + 1;
+      }
+    }
+    return ranges;
+  }
+}
+
+
+
+//---- CsrGraph ----//
+
+Graph CsrGraph::toGraph() const {
+  Graph graph(V);
+  for (int v = 0; v < V; v++) {
+    NeighbourSpan span = neighbours(v);
+    graph.adj[v].assign(span.begin(), span.end());
+  }
+  graph.canonical = deduped;
+  return graph;
+}
+
+CsrGraph CsrGraph::fromGraph(const Graph& graph) {
+  CsrGraph csrGraph;
+  csrGraph.V = graph.V;
+  csrGraph.offsets.assign(graph.V + 1, 0);
+  for (int v = 0; v < graph.V; v++) {
+    csrGraph.offsets[v + 1] = csrGraph.offsets[v] + graph.adj[v].size();
+  }
+
+  // Canonical multigraphs are sorted but may still repeat neighbours
+  bool deduped = graph.isCanonical();
+  csrGraph.neighbourList.reserve(csrGraph.offsets[graph.V]);
+  for (const auto& list : graph.adj) {
+    csrGraph.neighbourList.insert(csrGraph.neighbourList.end(), list.begin(), list.end());
+    if (deduped) deduped = std::adjacent_find(list.begin(), list.end()) == list.end();
+  }
+  csrGraph.deduped = deduped;
+  return csrGraph;
+}
+
+
+
+//---- Builder ----//
+
+namespace csr {
+
+  CsrGraph buildSymmetric(int n, const std::pair<int, int> *edges, size_t count, const BuildOptions& options) {
+    unsigned threads = threadCount(options, count);
+    // Deduped lists hold each neighbour once, which leaves no place for both half-edges of a loop
+    bool dropSelfLoops = options.dropSelfLoops || options.dedupe;
+
+    // 1. Degree count
+    std::unique_ptr<std::atomic<uint64_t>[]> cursor(new std::atomic<uint64_t>[n + 1]);
+    for (int v = 0; v <= n; v++) cursor[v].store(0, std::memory_order_relaxed);
+
+    forEachSlice(threads, count, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++) {
+        int u = edges[i].first, v = edges[i].second;
+        if (dropSelfLoops && u == v) continue;
+        cursor[u].fetch_add(1, std::memory_order_relaxed);
+        cursor[v].fetch_add(1, std::memory_order_relaxed);
+      }
+    });
+
+    // 2. Prefix sum, cursor becomes the next free slot of each list
+    CsrGraph graph;
+    graph.V = n;
+    graph.offsets.assign(n + 1, 0);
+    for (int v = 0; v < n; v++) {
+      uint64_t degree = cursor[v].load(std::memory_order_relaxed);
+      graph.offsets[v + 1] = graph.offsets[v] + degree;
+      cursor[v].store(graph.offsets[v], std::memory_order_relaxed);
+    }
+
+    // 3. Scatter both half-edges
+    graph.neighbourList.resize(graph.offsets[n]);
+    int *list = graph.neighbourList.data();
+    forEachSlice(threads, count, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++) {
+        int u = edges[i].first, v = edges[i].second;
+        if (dropSelfLoops && u == v) continue;
+        list[cursor[u].fetch_add(1, std::memory_order_relaxed)] = v;
+        list[cursor[v].fetch_add(1, std::memory_order_relaxed)] = u;
+      }
+    });
+    cursor.reset();
+
+    // 4. Sort every list (scatter order depends on thread timing), dedupe if requested
+    std::vector<uint64_t> degrees(options.dedupe ? n : 0);
+    std::vector<std::pair<int, int>> ranges = balancedRanges(graph.offsets, n, threads * 4);  // A few per thread, left for stealing
+    auto sortRange = [&](int begin, int end) {
+      for (int v = begin; v < end; v++) {
+        int *first = list + graph.offsets[v];
+        int *last = list + graph.offsets[v + 1];
+        std::sort(first, last);
+        if (options.dedupe) {
+          degrees[v] = std::unique(first, last) - first;
+        }
+      }
+    };
+    if (threads <= 1) {
+      sortRange(0, n);
+    } else {
+      sched::parallelFor(0, ranges.size(), 1, [&](size_t first, size_t last) {
+        for (size_t r = first; r < last; r++) sortRange(ranges[r].first, ranges[r].second);
+      });
+    }
+
+    // 5. Compact deduped lists, new positions are never ahead of the old ones
+    if (options.dedupe) {
+      uint64_t write = 0;
+      for (int v = 0; v < n; v++) {
+        uint64_t read = graph.offsets[v];
+        graph.offsets[v] = write;
+        std::copy(list + read, list + read + degrees[v], list + write);
+        write += degrees[v];
+      }
+      graph.offsets[n] = write;
+      graph.neighbourList.resize(write);
+      graph.neighbourList.shrink_to_fit();
+      graph.deduped = true;
+    }
+
+    return graph;
+  }
+
+  CsrGraph buildSymmetric(int n, const EdgeVector& edges, const BuildOptions& options) {
+    return buildSymmetric(n, edges.data(), edges.size(), options);
+  }
+
+  CsrGraph buildSymmetric(int n, const EdgeVector& edges) {
+    return buildSymmetric(n, edges.data(), edges.size(), BuildOptions());
+  }
+
+
+  Builder::Builder(int n, BuildOptions options) : n(n), options(options) {}
+
+  void Builder::append(const std::pair<int, int> *pairs, size_t count) {
+    edges.insert(edges.end(), pairs, pairs + count);
+  }
+
+  CsrGraph Builder::build() {
+    CsrGraph graph = buildSymmetric(n, edges, options);
+    EdgeVector().swap(edges);
+    return graph;
+  }
+}
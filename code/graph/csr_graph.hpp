@@ -0,0 +1,151 @@
+#ifndef CSR_GRAPH_HPP
+#define CSR_GRAPH_HPP
+
+#include "graph.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+
+/**
+ * @brief Graph stored as Compressed Sparse Rows
+ *
+ * Neighbours of v are neighbourList[offsets[v] ... offsets[v+1]-1]. Built in bulk by
+ * csr::buildSymmetric, where every list comes out sorted.
+ */
+struct CsrGraph {
+    using Vertex = int;
+    using TraitsType = DefaultGraphTraits;
+
+    /// @brief Contiguous neighbour list, usable on range-for loops
+    struct NeighbourSpan {
+        const int *first;
+        const int *last;
+
+        const int* begin() const { return first; }
+        const int* end() const { return last; }
+        size_t size() const { return static_cast<size_t>(last - first); }
+    };
+
+    int V = 0;                      // Vertex quantity
+    std::vector<uint64_t> offsets;  // [V + 1] start of each list
+    std::vector<int> neighbourList; // Every half-edge, grouped by source vertex
+    bool deduped = false;           // Lists are sorted and have no repeated neighbour
+
+    NeighbourSpan neighbours(int v) const {
+        const int *base = neighbourList.data();
+        return NeighbourSpan{base + offsets[v], base + offsets[v + 1]};
+    }
+
+    int getVertexQuantity() const { return V; }
+
+    int getEdgeQuantity(int v) const { return static_cast<int>(offsets[v + 1] - offsets[v]); }
+
+    int getTotalQuantityEdges() const { return static_cast<int>(neighbourList.size() / 2); }
+
+    /// @brief Copies into a mutable graph, allocating each list once. Deduped graphs become canonical
+    Graph toGraph() const;
+
+    /// @brief Flattens a graph into CSR form, keeping the order of every list
+    static CsrGraph fromGraph(const Graph& graph);
+};
+
+
+/**
+ * @brief CSR arrays owned by someone else, read in place
+ *
+ * Same layout and interface as CsrGraph, so the templated engines (Tarjan, degree parity)
+ * run over arrays that came from outside (C callers, mapped files) without copying them.
+ * The arrays must outlive the view.
+ */
+struct CsrView {
+    using Vertex = int;
+    using TraitsType = DefaultGraphTraits;
+    using NeighbourSpan = CsrGraph::NeighbourSpan;
+
+    int V = 0;
+    const uint64_t *offsets = nullptr;    // [V + 1]
+    const int *neighbourList = nullptr;   // [offsets[V]]
+
+    CsrView() = default;
+    CsrView(int V, const uint64_t *offsets, const int *neighbourList) : V(V), offsets(offsets), neighbourList(neighbourList) {}
+    CsrView(const CsrGraph& graph) : V(graph.V), offsets(graph.offsets.data()), neighbourList(graph.neighbourList.data()) {}
+
+    NeighbourSpan neighbours(int v) const {
+        return NeighbourSpan{neighbourList + offsets[v], neighbourList + offsets[v + 1]};
+    }
+
+    int getVertexQuantity() const { return V; }
+
+    int getEdgeQuantity(int v) const { return static_cast<int>(offsets[v + 1] - offsets[v]); }
+
+    uint64_t getHalfEdgeQuantity() const { return V > 0 ? offsets[V] : 0; }
+
+    int getTotalQuantityEdges() const { return static_cast<int>(getHalfEdgeQuantity() / 2); }
+};
+
+
+namespace csr {
+
+    struct BuildOptions {
+        bool dedupe = false;         // Removes repeated edges, (u,v) and (v,u) are the same edge. Implies dropSelfLoops:
+                                     // a self-loop is two entries of u on its own list, keeping one would make its degree odd
+        bool dropSelfLoops = false;  // Ignores (u,u) pairs
+        unsigned threads = 0;        // Slices of each pass, 0 uses sched::threadCount()
+    };
+
+    /**
+     * @brief Builds a symmetric CSR graph from unsorted (u,v) pairs
+     *
+     * Parallel counting sort by source vertex:
+     * - degrees are counted with atomic increments over chunks of the input
+     * - a prefix sum turns degrees into offsets
+     * - both half-edges of every pair are scattered to their slots
+     * - each list is sorted (and deduped) by vertex ranges of similar size
+     *
+     * Every pair must hold vertices on range [0 ... n-1]. Without dedupe a self-loop (u,u)
+     * puts u twice on its own list, as BasicGraph::addEdge does; with dedupe it is dropped.
+     *
+     * @param n Vertex quantity
+     * @param edges Raw pair array, each pair is inserted on both directions
+     * @param count Number of pairs
+     * @param options Dedupe, self-loop and thread settings
+     */
+    CsrGraph buildSymmetric(int n, const std::pair<int, int> *edges, size_t count, const BuildOptions& options);
+
+    CsrGraph buildSymmetric(int n, const EdgeVector& edges, const BuildOptions& options);
+
+    CsrGraph buildSymmetric(int n, const EdgeVector& edges);
+
+
+    /**
+     * @brief Accumulates an edge stream in blocks and builds the CSR graph at the end
+     *
+     * Used by importers that do not know the edge count beforehand
+     */
+    class Builder {
+      private:
+        int n;
+        BuildOptions options;
+        EdgeVector edges;
+
+      public:
+        Builder(int n, BuildOptions options);
+
+        void reserve(size_t count) { edges.reserve(count); }
+
+        void add(int u, int v) { edges.emplace_back(u, v); }
+
+        void append(const std::pair<int, int> *pairs, size_t count);
+
+        size_t size() const { return edges.size(); }
+
+        /// @brief Builds the graph and releases the accumulated pairs
+        CsrGraph build();
+    };
+}
+
+
+#endif  // CSR_GRAPH_HPP
@@ -1,5 +1,7 @@
 #include "graph.hpp"
 #include "randomizer.hpp"
+#include "trace.hpp"
+#include "scheduler.hpp"
 
 #include <iostream>
 #include <vector>
@@ -27,71 +29,185 @@ std::string edgelist_to_string(EdgeVector list) {
 ///GRAFO
 
 //---- Métodos auxiliares (private) ----//
-void Graph::createRandomGraphLog(const std::string& s) {
+template <typename Traits>
+void BasicGraph<Traits>::createRandomGraphLog(const std::string& s) {
   std::cout << s;
 }
 
+namespace {
+  // Below this amount of half-edges the threads cost more than the sort itself
+  const size_t PARALLEL_SORT_THRESHOLD = 1 << 16;
+
+  /// @brief Parallel edges and both half-edges of a self-loop are kept on multigraphs
+  template <typename Traits, typename Vertex>
+  void sortAndDedupe(std::vector<std::vector<Vertex>>& adj, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      std::vector<Vertex>& list = adj[i];
+      std::sort(list.begin(), list.end());
+      if constexpr (!Traits::multigraph) {
+        list.erase(std::unique(list.begin(), list.end()), list.end());
+      }
+    }
+  }
+
+  // splitmix64 finalizer
+  uint64_t mix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  }
+}
+
 
 //---- Métodos públicos ----//
 
-Graph::Graph() : V(0) {
+template <typename Traits>
+BasicGraph<Traits>::BasicGraph() : V(0) {
   adj.resize(V);
 }
 
-Graph::Graph(int v) : V(v) {
+template <typename Traits>
+BasicGraph<Traits>::BasicGraph(Vertex v) : V(v) {
   adj.resize(V);
 }
 
-bool Graph::hasEdge(int u, int v){
-  bool test = false;
-  for(int neigbour : adj[u]){
-    if(neigbour == v){
-      test = true;
-    }
+template <typename Traits>
+bool BasicGraph<Traits>::hasEdge(Vertex u, Vertex v) const {
+  if (canonical) {
+    return std::binary_search(adj[u].begin(), adj[u].end(), v);
   }
-  return test;
+  return std::find(adj[u].begin(), adj[u].end(), v) != adj[u].end();
 }
 
-void Graph::pushEdge(int u, int v) {
+template <typename Traits>
+void BasicGraph<Traits>::pushEdge(Vertex u, Vertex v) {
+  if (canonical) {
+    auto it = std::upper_bound(adj[u].begin(), adj[u].end(), v);
+    if constexpr (!Traits::multigraph) {
+      if (it != adj[u].begin() && *(it - 1) == v) return;
+    }
+    adj[u].insert(it, v);
+    return;
+  }
+  if constexpr (!Traits::multigraph) {
+    if (hasEdge(u, v)) return;
+  }
   adj[u].push_back(v);
 }
 
-void Graph::addEdge(int u, int v) {
-  adj[u].push_back(v);
-  adj[v].push_back(u);
+template <typename Traits>
+void BasicGraph<Traits>::addEdge(Vertex u, Vertex v) {
+  pushEdge(u, v);
+  if constexpr (!Traits::directed) {
+    pushEdge(v, u);
+  }
 }
 
-void Graph::removeEdge(int u, int v) {
-  adj[u].remove(v);
-  adj[v].remove(u);
+template <typename Traits>
+void BasicGraph<Traits>::removeEdge(Vertex u, Vertex v) {
+  if (canonical) {
+    // Every occurrence, same as below
+    auto range = std::equal_range(adj[u].begin(), adj[u].end(), v);
+    adj[u].erase(range.first, range.second);
+
+    if constexpr (!Traits::directed) {
+      range = std::equal_range(adj[v].begin(), adj[v].end(), u);
+      adj[v].erase(range.first, range.second);
+    }
+    return;
+  }
+  // Removes every occurrence, as std::list::remove did
+  adj[u].erase(std::remove(adj[u].begin(), adj[u].end(), v), adj[u].end());
+  if constexpr (!Traits::directed) {
+    adj[v].erase(std::remove(adj[v].begin(), adj[v].end(), u), adj[v].end());
+  }
 }
 
 
+template <typename Traits>
+void BasicGraph<Traits>::canonicalize() {
+  size_t n = adj.size();
+  size_t halfEdges = 0;
+  for (const auto& list : adj) halfEdges += list.size();
+
+  size_t threads = sched::threadCount();
+  if (halfEdges < PARALLEL_SORT_THRESHOLD || threads == 1 || n < threads) {
+    sortAndDedupe<Traits>(adj, 0, n);
+    canonical = true;
+    return;
+  }
+
+  // Ranges with roughly the same quantity of half-edges each, a few per thread so that
+  // idle workers can steal the rest
+  std::vector<std::pair<size_t, size_t>> ranges;
+  size_t target = halfEdges / (threads * 4) + 1;
+  size_t begin = 0, accumulated = 0;
+  for (size_t i = 0; i < n; i++) {
+    accumulated += adj[i].size();
+    if (accumulated >= target || i == n - 1) {
+      ranges.push_back({begin, i + 1});
+      begin = i + 1;
+      accumulated = 0;
+    }
+  }
 
-bool Graph::isConnected() const {
-  int start = 0;
+  sched::parallelFor(0, ranges.size(), 1, [&](size_t first, size_t last) {
+    for (size_t r = first; r < last; r++) sortAndDedupe<Traits>(adj, ranges[r].first, ranges[r].second);
+  });
+  canonical = true;
+}
+
+template <typename Traits>
+uint64_t BasicGraph<Traits>::fingerprint() const {
+  uint64_t hash = mix(static_cast<uint64_t>(V));
+  for (Vertex u = 0; u < V; u++) {
+    uint64_t base = mix(static_cast<uint64_t>(u));
+    for (Vertex v : adj[u]) {
+      hash += mix(base ^ static_cast<uint64_t>(v));
+    }
+  }
+  return hash;
+}
+
+
+
+template <typename Traits>
+bool BasicGraph<Traits>::isConnected() const {
+  algostats::NoStats stats;
+  return isConnected(stats);
+}
+
+template <typename Traits>
+template <typename Stats>
+bool BasicGraph<Traits>::isConnected(Stats& stats) const {
+  Vertex start = 0;
+  stats.traversal();
 
   std::vector<bool> visited(V, false);
   
   // DFS iterativa para evitar estouro de pilha (stack overflow)
-  std::stack<int> stack;
+  std::stack<Vertex> stack;
   stack.push(start);
   visited[start] = true;
 
   while (!stack.empty()) {
-      int u = stack.top();
+      Vertex u = stack.top();
       stack.pop();
+      stats.visitVertex();
 
-      for (int v : adj[u]) {
+      for (Vertex v : adj[u]) {
+          stats.scanEdge();
           if (!visited[v]) {
               visited[v] = true;
               stack.push(v);
           }
       }
+      stats.stackSize(stack.size());
   }
 
   // Verificar se todos os vértices foram visitados
-  for (int i = 0; i < V; ++i) {
+  for (Vertex i = 0; i < V; ++i) {
       if (!visited[i]) return false;
   }
   
@@ -101,11 +217,13 @@ bool Graph::isConnected() const {
 
 
 
-int Graph::getEdgeQuantity(int v) const{
-  return adj[v].size();
+template <typename Traits>
+typename BasicGraph<Traits>::EdgeIndex BasicGraph<Traits>::getEdgeQuantity(Vertex v) const{
+  return static_cast<EdgeIndex>(adj[v].size());
 }
 
-int Graph::getVertexQuantity() const{
+template <typename Traits>
+typename BasicGraph<Traits>::Vertex BasicGraph<Traits>::getVertexQuantity() const{
   return V;
 }
 
@@ -113,14 +231,15 @@ int Graph::getVertexQuantity() const{
 
 
 /// @section Displays
-std::string Graph::toString() const {
+template <typename Traits>
+std::string BasicGraph<Traits>::toString() const {
   std::ostringstream s;
-  for (int i = 0; i < V; ++i) {
+  for (Vertex i = 0; i < V; ++i) {
     s << "Vertex " << i << ": ";
     if(adj[i].empty()){
       s << "(no connections)";
     }
-    for (int neighbor : adj[i]) {
+    for (Vertex neighbor : adj[i]) {
       s << neighbor << ", ";
     }
     s << std::endl;
@@ -128,12 +247,13 @@ std::string Graph::toString() const {
   return s.str();
 }
 
-std::string Graph::toStringBrief() const {
+template <typename Traits>
+std::string BasicGraph<Traits>::toStringBrief() const {
     std::ostringstream oss;
     oss << "Resulting Graph:\n";
-    for (int i = 0; i < V; i++) {
+    for (Vertex i = 0; i < V; i++) {
         oss << i << " -> ";
-        for (int element : adj[i]) {
+        for (Vertex element : adj[i]) {
             oss << element << " ";
         }
         oss << "\n";
@@ -141,36 +261,82 @@ std::string Graph::toStringBrief() const {
     return oss.str();
 }
 
-void Graph::show() {
+template <typename Traits>
+void BasicGraph<Traits>::show() {
   std::cout << toStringBrief();
 }
 
-bool Graph::isEqual(const Graph& graph) {
+template <typename Traits>
+bool BasicGraph<Traits>::isEqual(const BasicGraph& graph) const {
   if(adj.size() != graph.adj.size()) return false;
-  
-  return std::equal(adj.begin(), adj.end(), graph.adj.begin());
-  
+
+  // Sorted lists can be compared directly
+  if (canonical && graph.canonical) {
+    return adj == graph.adj;
+  }
+
+  for (Vertex i = 0; i < V; i++) {
+    if (adj[i].size() != graph.adj[i].size()) return false;
+  }
+  if (fingerprint() != graph.fingerprint()) return false;
+
+  // Equal fingerprints, confirm with a merge of the sorted lists
+  std::vector<Vertex> a, b;
+  for (Vertex i = 0; i < V; i++) {
+    const std::vector<Vertex>& first = adj[i];
+    const std::vector<Vertex>& second = graph.adj[i];
+    if (!canonical) {
+      a.assign(first.begin(), first.end());
+      std::sort(a.begin(), a.end());
+    }
+    if (!graph.canonical) {
+      b.assign(second.begin(), second.end());
+      std::sort(b.begin(), b.end());
+    }
+    if (!std::equal(canonical ? first.begin() : a.begin(), canonical ? first.end() : a.end(),
+                    graph.canonical ? second.begin() : b.begin(), graph.canonical ? second.end() : b.end())) {
+      return false;
+    }
+  }
+  return true;
 }
 
-int Graph::getTotalQuantityEdges() const {
-  int total = 0;
-  for (int i = 0; i < V; i++) {
+template <typename Traits>
+typename BasicGraph<Traits>::EdgeIndex BasicGraph<Traits>::getTotalQuantityEdges() const {
+  EdgeIndex total = 0;
+  for (Vertex i = 0; i < V; i++) {
     total += adj[i].size();
   }
+  if constexpr (Traits::directed) {
+    return total;
+  }
   return total/2;
 }
 
-Graph Graph::clone(const Graph& original) {
-  Graph newGraph(original.V);
-  for (int i = 0; i < original.V; ++i) {
+template <typename Traits>
+BasicGraph<Traits> BasicGraph<Traits>::clone(const BasicGraph& original) {
+  TRACE_SPAN("graph.clone");
+  BasicGraph newGraph(original.V);
+  for (Vertex i = 0; i < original.V; ++i) {
     newGraph.adj[i] = original.adj[i];
   }
+  newGraph.canonical = original.canonical;
   return newGraph;
 }
 
 
+template class BasicGraph<DefaultGraphTraits>;
+template class BasicGraph<SmallGraphTraits>;
+template class BasicGraph<WideGraphTraits>;
+template class BasicGraph<SimpleGraphTraits>;
+template class BasicGraph<DirectedGraphTraits>;
 
+#define INSTANTIATE_CONNECTED_STATS(Traits) \
+  template bool BasicGraph<Traits>::isConnected<algostats::NoStats>(algostats::NoStats& stats) const; \
+  template bool BasicGraph<Traits>::isConnected<algostats::CountingStats>(algostats::CountingStats& stats) const;
 
-
-
-
+INSTANTIATE_CONNECTED_STATS(DefaultGraphTraits)
+INSTANTIATE_CONNECTED_STATS(SmallGraphTraits)
+INSTANTIATE_CONNECTED_STATS(WideGraphTraits)
+INSTANTIATE_CONNECTED_STATS(SimpleGraphTraits)
+INSTANTIATE_CONNECTED_STATS(DirectedGraphTraits)
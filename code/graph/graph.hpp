@@ -8,8 +8,12 @@
 #include <sstream>
 #include <random>
 #include <unordered_set>
+#include <cstdint>
 
-typedef std::vector<std::pair<int,int>> EdgeVector;
+#include "graph_traits.hpp"
+#include "algorithm_stats.hpp"
+
+typedef BasicEdgeVector<int> EdgeVector;
 /**
  * @brief Formats EdgeList content to string text
  *
@@ -26,31 +30,75 @@ std::string edgelist_to_string(EdgeVector list);
 
 
 
-class Graph {
+/**
+ * @brief Adjacency list graph, specialized at compile time by GraphTraits
+ *
+ * Instantiated on graph.cpp for DefaultGraphTraits (`Graph`), SmallGraphTraits,
+ * WideGraphTraits, SimpleGraphTraits and DirectedGraphTraits
+ */
+template <typename Traits>
+class BasicGraph {
+  friend struct CsrGraph;
+
+  public:
+    using Vertex = typename Traits::Vertex;
+    using EdgeIndex = typename Traits::EdgeIndex;
+    using TraitsType = Traits;
+
   private:
     /// @brief custom random graph generator log behaviour
     static void createRandomGraphLog(const std::string& s);
 
+    /// @brief true while every list is sorted, and without duplicates on simple graphs (see canonicalize)
+    bool canonical = false;
+
 
   public:
-    int V;                            // Vertex quantity
-    std::vector<std::list<int>> adj;  // Adjascent list set
+    Vertex V;                                 // Vertex quantity
+    std::vector<std::vector<Vertex>> adj;     // Adjascent list set
+
+    BasicGraph();
+
+    BasicGraph(Vertex V);
+
+    /// @brief Inserts an directed edge from u to v. On canonical mode, keeps the list sorted (and unique on simple graphs)
+    void pushEdge(Vertex u, Vertex v);
 
-    Graph();
+    /// @brief Inserts an undirected edge between u and v (only u -> v on directed graphs)
+    void addEdge(Vertex u, Vertex v);
 
-    Graph(int V);
+    /// @brief removes an undirected edge between u and v (only u -> v on directed graphs)
+    void removeEdge(Vertex u, Vertex v);
 
-    /// @brief Inserts an directed edge from u to v
-    void pushEdge(int u, int v);
+    /// @brief Checks the existence of an undirected edge between u and v. Binary search on canonical mode
+    bool hasEdge(Vertex u, Vertex v) const;
 
-    /// @brief Inserts an undirected edge between u and v
-    void addEdge(int u, int v);
+    /// @brief Neighbour list of v, same accessor used by CompressedGraph on generic traversals
+    const std::vector<Vertex>& neighbours(Vertex v) const { return adj[v]; }
 
-    /// @brief removes an undirected edge between u and v
-    void removeEdge(int u, int v);
+    /**
+     * @brief Sorts every neighbour list, entering canonical mode
+     *
+     * Duplicates are only removed when the traits describe a simple graph: on multigraphs
+     * parallel edges and both half-edges of a self-loop are kept, so bridges and degree
+     * parity do not change. Lists are split in contiguous vertex ranges sorted by separate
+     * threads. While on canonical mode, insertions and removals keep lists sorted, so hasEdge
+     * is a binary search and isEqual is a direct comparison of the lists.
+     *
+     * Only pushEdge, addEdge and removeEdge keep the mode: a caller that edits `adj`
+     * directly must call canonicalize() again before relying on it.
+     */
+    void canonicalize();
 
-    /// @brief Checks the existence of an undirected edge between u and v
-    bool hasEdge(int u, int v);
+    bool isCanonical() const { return canonical; }
+
+    /**
+     * @brief Order-independent 64 bit hash of the graph structure
+     *
+     * Every half-edge (u, v) is mixed independently and summed, so two graphs with the
+     * same multiset of edges have the same fingerprint regardless of insertion order
+     */
+    uint64_t fingerprint() const;
 
     /**
      * @brief Formats graph content to string text
@@ -68,26 +116,34 @@ class Graph {
     std::string toStringBrief() const;
     
 
-    /// @brief Verify if the graph is connected
+    /// @brief Verify if the graph is connected (every vertex reachable from 0 on directed graphs)
     bool isConnected() const;
 
-    int getVertexQuantity() const;
+    /// @brief Same as isConnected(), reporting the traversal to a statistics policy (see algorithm_stats.hpp)
+    template <typename Stats>
+    bool isConnected(Stats& stats) const;
+
+    Vertex getVertexQuantity() const;
 
-    int getEdgeQuantity(int v) const;
+    EdgeIndex getEdgeQuantity(Vertex v) const;
 
     //static Graph read_graph_from_file();
 
     void show();
 
-    bool isEqual(const Graph& graph);
+    /// @brief Compares the edge multisets of both graphs, independent of insertion order
+    bool isEqual(const BasicGraph& graph) const;
 
-    int getTotalQuantityEdges() const;
+    EdgeIndex getTotalQuantityEdges() const;
 
     /// @brief Creates a deep copy of the given graph
-    static Graph clone(const Graph& original);
+    static BasicGraph clone(const BasicGraph& original);
 };
 
 
+typedef BasicGraph<DefaultGraphTraits> Graph;
+
+
 
 
 #endif  // GRAPH_HPP
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "graph.hpp"
 #include "graph_reader.hpp"
+#include "csr_graph.hpp"
 #include "response_struct.hpp"
+#include "trace.hpp"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -10,6 +12,15 @@
 #include <chrono>
 #include <string>
 #include <filesystem>
+#include <cstring>
+#include <cerrno>
+#include <memory>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#endif
 
 
 
@@ -19,10 +30,10 @@ namespace graphtext {
         size_t pos;
         int num = std::stoi(s, &pos); // Convert to integer using std::stoi
         if (pos != s.size()) {
-            return Response<int>("Number conversion from string to int failed", 0);
+            return Response<int>(ErrorCode::INVALID_FORMAT, "Number conversion from string to int failed");
         }
 
-        return Response<int>(num);
+        return Response<int>(std::move(num));
     }
 
     Response<std::vector<int>> read_numbers(std::string line) {
@@ -36,19 +47,19 @@ namespace graphtext {
             try {
                 Response<int> num = read_number(temp);
                 if (!num.isOk()) {
-                    return Response<std::vector<int>>(std::move(num.message), {});
+                    return Response<std::vector<int>>(num.code, std::move(num.message));
                 }
 
                 numbers.push_back(num.value); 
             } catch (const std::invalid_argument& e) {
-                return Response<std::vector<int>>("Invalid character found", {});
+                return Response<std::vector<int>>(ErrorCode::INVALID_FORMAT, "Invalid character found");
 
             } catch (const std::out_of_range& e) {
-                return Response<std::vector<int>>("Out of range error", {});
+                return Response<std::vector<int>>(ErrorCode::INVALID_FORMAT, "Out of range error");
             }
         }
 
-        return Response<std::vector<int>>(numbers);
+        return Response<std::vector<int>>(std::move(numbers));
     }
 
 
@@ -69,7 +80,7 @@ namespace graphtext {
             return {};
         }
 
-        std::vector<int> values = res.value;
+        std::vector<int> values = std::move(res.value);
         if (values.size() != 1) {
             std::cerr << "Graph Read  Error: Incorrect number of paramenters on first line" << std::endl;
             return {};
@@ -121,6 +132,34 @@ namespace graphtext {
 
         outFile.close();
     }
+
+
+    Response<Graph> read_edge_list(std::ifstream &file) {
+        csr::BuildOptions options;
+        options.dedupe = true;
+        options.dropSelfLoops = true;
+
+        EdgeVector edges;
+        std::string line;
+        int maxVertex = -1;
+        long lineNumber = 0;
+
+        while (std::getline(file, line)) {
+            lineNumber++;
+            if (line.empty() || line[0] == '#' || line[0] == '%') continue;
+
+            std::istringstream iss(line);
+            long u, v;
+            if (!(iss >> u >> v) || u < 0 || v < 0 || u > INT32_MAX - 1 || v > INT32_MAX - 1) {
+                return Response<Graph>(ErrorCode::INVALID_FORMAT, "Edge list read error: invalid edge on line " + std::to_string(lineNumber));
+            }
+
+            edges.emplace_back(static_cast<int>(u), static_cast<int>(v));
+            maxVertex = std::max(maxVertex, static_cast<int>(std::max(u, v)));
+        }
+
+        return Response<Graph>(csr::buildSymmetric(maxVertex + 1, edges, options).toGraph());
+    }
 }
 
 namespace graphformat {
@@ -128,32 +167,58 @@ namespace graphformat {
         return std::chrono::duration_cast<std::chrono::milliseconds> (end - begin).count();
     }
     
-    Response<Graph> readGraphFromFile(const std::string& filename, std::vector<char>& ioBuffer) {
-        std::ifstream in(filename);
-        if (!in) return Response<Graph>("Error: Could not open input file for reading", {});
-        
-        in.rdbuf()->pubsetbuf(ioBuffer.data(), ioBuffer.capacity());
+    // Callers may clear() the buffer between uses, the capacity is what they meant to lend
+    void __attachBuffer(std::basic_ios<char>& stream, std::vector<char>& ioBuffer) {
+        ioBuffer.resize(ioBuffer.capacity());
+        if (!ioBuffer.empty()) stream.rdbuf()->pubsetbuf(ioBuffer.data(), ioBuffer.size());
+    }
 
-        int number;
+    Response<Graph> readGraphFromFile(const std::string& filename, std::vector<char>& ioBuffer) {
+        TRACE_SPAN("graph.read");
+        std::ifstream in;
+        __attachBuffer(in, ioBuffer);
+        in.open(filename, std::ios::binary);
+        if (!in) return Response<Graph>(ErrorCode::OPEN_FAILED, "Error: Could not open input file for reading");
+
+        // Every size read from the file is checked against the bytes still left on it
+        std::error_code sizeError;
+        uint64_t left = std::filesystem::file_size(filename, sizeError);
+        if (sizeError) return Response<Graph>(ErrorCode::READ_FAILED, "Error: Could not get input file size");
+
+        int number = 0;
         in.read(reinterpret_cast<char*>(&number), sizeof(number));
+        if (!in || number < 0) return Response<Graph>(ErrorCode::INVALID_FORMAT, "Error: Invalid vertex quantity on input file");
+        left -= sizeof(number);
+        if (static_cast<uint64_t>(number) > left / sizeof(int)) {
+            return Response<Graph>(ErrorCode::INVALID_FORMAT, "Error: Vertex quantity larger than the input file");
+        }
 
         Graph graph(number);
 
-        int *buffer = new int[number];
+        // Lists are already grouped by vertex, so they are read straight into place
         for (int i = 0; i < number; i++) {
             int length;
             in.read(reinterpret_cast<char*>(&length), sizeof(int));
-            in.read(reinterpret_cast<char*>(buffer), sizeof(int) * length);
+            left -= sizeof(int);
+            // The lengths of the remaining vertices still need their 4 bytes each
+            uint64_t available = left / sizeof(int) - static_cast<uint64_t>(number - 1 - i);
+            if (!in || length < 0 || static_cast<uint64_t>(length) > available) {
+                return Response<Graph>(ErrorCode::READ_FAILED, "Error: Corrupted adjacency list on input file");
+            }
+
+            graph.adj[i].resize(length);
+            in.read(reinterpret_cast<char*>(graph.adj[i].data()), sizeof(int) * length);
+            if (!in) return Response<Graph>(ErrorCode::READ_FAILED, "Error: Corrupted adjacency list on input file");
+            left -= sizeof(int) * static_cast<uint64_t>(length);
 
-            for (int *ptr = buffer; ptr < buffer+length; ptr++) {
-                graph.pushEdge(i, *ptr);
+            for (int v : graph.adj[i]) {
+                if (v < 0 || v >= number) return Response<Graph>(ErrorCode::INVALID_FORMAT, "Error: Neighbour out of range on input file");
             }
         }
 
-        delete[] buffer;
         in.close();
 
-        return Response(graph);
+        return Response<Graph>(std::move(graph));
     }
 
     TimedResponse<Graph> timedReadGraphFromFile(const std::string& filename, std::vector<char>& ioBuffer) {
@@ -162,12 +227,17 @@ namespace graphformat {
         begin = std::chrono::steady_clock::now();
 
         Response<Graph> res = readGraphFromFile(filename, ioBuffer);
-        if (!res.isOk()) return TimedResponse<Graph>(std::move(res.message), 0, {});
+        if (!res.isOk()) return TimedResponse<Graph>(res.code, std::move(res.message), 0);
         
         end = std::chrono::steady_clock::now();
         
+        uint64_t bytes = sizeof(int) * (1 + static_cast<uint64_t>(res.value.V) + 2 * static_cast<uint64_t>(res.value.getTotalQuantityEdges()));
+        double seconds = std::chrono::duration<double>(end - begin).count();
 
-        return TimedResponse<Graph>(__getDuration(begin, end), res.value);
+        TimedResponse<Graph> timed(__getDuration(begin, end), std::move(res.value));
+        timed.bytes = bytes;
+        timed.bytesPerSecond = seconds > 0 ? bytes / seconds : 0;
+        return timed;
     }
 
 
@@ -178,32 +248,25 @@ namespace graphformat {
 
 
     Response<void> writeGraphToFile(const std::string& filename, std::vector<char>& ioBuffer, const Graph &graph) {
-        std::chrono::steady_clock::time_point begin, end; 
-        
-        std::ofstream out(filename, std::ios::binary | std::ios::trunc);
-        if (!out) return Response<void>("Error: Could not open output file for writing");
-    
-        ioBuffer.clear();
-
-        out.rdbuf()->pubsetbuf(ioBuffer.data(), ioBuffer.capacity());
+        TRACE_SPAN("graph.write");
+        std::ofstream out;
+        __attachBuffer(out, ioBuffer);
+        out.open(filename, std::ios::binary | std::ios::trunc);
+        if (!out) return Response<void>(ErrorCode::OPEN_FAILED, "Error: Could not open output file for writing");
 
         // Write number of vertices
         int numVertices = graph.adj.size();
         out.write(reinterpret_cast<const char*>(&numVertices), sizeof(numVertices));
 
-        // Write adjacency list
-    
+        // Write adjacency list, each one with a single call
         for (const auto& neighbors : graph.adj) {
             int numNeighbors = neighbors.size();
             out.write(reinterpret_cast<const char*>(&numNeighbors), sizeof(numNeighbors));
-
-            // Write each neighbor
-            for (int neighbor : neighbors) {
-                out.write(reinterpret_cast<const char*>(&neighbor), sizeof(neighbor));
-            }
+            out.write(reinterpret_cast<const char*>(neighbors.data()), sizeof(int) * numNeighbors);
         }
         
         out.close();
+        if (!out) return Response<void>(ErrorCode::WRITE_FAILED, "Error: Could not write output file");
 
         return Response<void>();
     }
@@ -215,11 +278,236 @@ namespace graphformat {
         begin = std::chrono::steady_clock::now();
 
         Response<void> res = writeGraphToFile(filename, ioBuffer, graph);
-        if (!res.isOk()) return TimedResponse<void>(std::move(res.message), 0);
+        if (!res.isOk()) return TimedResponse<void>(res.code, std::move(res.message), 0);
         
         end = std::chrono::steady_clock::now();
 
-        return TimedResponse<void>(std::move(__getDuration(begin,end)));
+        TimedResponse<void> timed(__getDuration(begin,end));
+        double seconds = std::chrono::duration<double>(end - begin).count();
+        timed.bytes = sizeof(int) * (1 + static_cast<uint64_t>(graph.adj.size()) + 2 * static_cast<uint64_t>(graph.getTotalQuantityEdges()));
+        timed.bytesPerSecond = seconds > 0 ? timed.bytes / seconds : 0;
+        return timed;
+    }
+
+
+
+    //---- Escrita em lote ----//
+
+    /// @brief Header, then the length and the list of every vertex, in file order
+    template <typename LengthOf, typename ListOf, typename Emit>
+    bool __forEachChunk(int V, LengthOf lengthOf, ListOf listOf, Emit emit) {
+        if (!emit(&V, sizeof(int))) return false;
+        for (int v = 0; v < V; v++) {
+            int length = lengthOf(v);
+            if (!emit(&length, sizeof(int))) return false;
+            if (length > 0 && !emit(listOf(v), sizeof(int) * static_cast<size_t>(length))) return false;
+        }
+        return true;
+    }
+
+#if defined(__linux__)
+
+    Response<void> __writeError(int fd, const char *what) {
+        std::string message = std::string("Error: ") + what + ": " + std::strerror(errno);
+        if (fd >= 0) ::close(fd);
+        return Response<void>(ErrorCode::WRITE_FAILED, message);
+    }
+
+    /**
+     * @brief Output of the batched writer
+     *
+     * Lengths and short lists are copied into one staging buffer, written when full. Lists of
+     * LONG_LIST_BYTES or more leave from the graph itself, on the same writev as the staged
+     * bytes before them. With O_DIRECT everything is staged: addresses and sizes must be aligned.
+     */
+    class __StagedWriter {
+      private:
+        static constexpr size_t ALIGNMENT = 4096;
+        static constexpr size_t LONG_LIST_BYTES = size_t(64) << 10;
+
+        int fd;
+        bool direct;
+        std::unique_ptr<char, decltype(&free)> buffer{nullptr, &free};
+        size_t capacity = 0;
+        size_t filled = 0;
+
+        /// @brief writev of every entry, resuming partial writes
+        bool __writeAll(iovec *iov, int count) {
+            int first = 0;
+            while (first < count) {
+                ssize_t written = ::writev(fd, iov + first, count - first);
+                if (written < 0 && errno == EINTR) continue;
+                if (written < 0) return false;
+
+                size_t left = static_cast<size_t>(written);
+                while (first < count && left >= iov[first].iov_len) {
+                    left -= iov[first].iov_len;
+                    first++;
+                }
+                if (first < count) {
+                    iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + left;
+                    iov[first].iov_len -= left;
+                }
+            }
+            return true;
+        }
+
+        bool __flush(size_t bytes) {
+            iovec staged = {buffer.get(), bytes};
+            filled = 0;
+            return __writeAll(&staged, 1);
+        }
+
+      public:
+        __StagedWriter(int fd, bool direct) : fd(fd), direct(direct) {}
+
+        bool allocate(size_t bufferBytes) {
+            capacity = std::max(ALIGNMENT, bufferBytes / ALIGNMENT * ALIGNMENT);
+            void *memory = nullptr;
+            if (posix_memalign(&memory, ALIGNMENT, capacity) != 0) return false;
+            buffer.reset(static_cast<char*>(memory));
+            return true;
+        }
+
+        bool append(const void *data, size_t size) {
+            const char *bytes = static_cast<const char*>(data);
+            if (!direct && size >= LONG_LIST_BYTES) {
+                iovec parts[2] = {{buffer.get(), filled}, {const_cast<char*>(bytes), size}};
+                filled = 0;
+                return __writeAll(parts, 2);
+            }
+
+            while (size > 0) {
+                size_t amount = std::min(size, capacity - filled);
+                std::memcpy(buffer.get() + filled, bytes, amount);
+                filled += amount;
+                bytes += amount;
+                size -= amount;
+                if (filled == capacity && !__flush(capacity)) return false;
+            }
+            return true;
+        }
+
+        /// @brief Writes what is left. Direct writes pad the last block, then cut the file back to `totalBytes`
+        bool finish(uint64_t totalBytes) {
+            if (!direct) return filled == 0 || __flush(filled);
+
+            if (filled > 0) {
+                size_t padded = (filled + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+                std::memset(buffer.get() + filled, 0, padded - filled);
+                if (!__flush(padded)) return false;
+            }
+            return ::ftruncate(fd, static_cast<off_t>(totalBytes)) == 0;
+        }
+    };
+
+    template <typename LengthOf, typename ListOf>
+    Response<void> __writeBatched(const std::string& filename, int V, LengthOf lengthOf, ListOf listOf, uint64_t totalBytes,
+                                  const WriteOptions& options) {
+        TRACE_SPAN("graph.write");
+        int flags = O_WRONLY | O_CREAT | O_TRUNC;
+        int fd = -1;
+        bool direct = false;
+
+        if (options.direct) {
+            fd = ::open(filename.c_str(), flags | O_DIRECT, 0644);
+            direct = fd >= 0;
+        }
+        // Filesystems such as tmpfs refuse O_DIRECT
+        if (fd < 0) fd = ::open(filename.c_str(), flags, 0644);
+        if (fd < 0) return Response<void>(ErrorCode::OPEN_FAILED, "Error: Could not open output file for writing");
+
+        if (options.preallocate && totalBytes > 0) {
+            // Not supported everywhere, the write still works without it
+            ::posix_fallocate(fd, 0, static_cast<off_t>(totalBytes));
+        }
+
+        __StagedWriter writer(fd, direct);
+        if (!writer.allocate(options.bufferBytes)) return __writeError(fd, "Could not allocate staging buffer");
+        bool written = __forEachChunk(V, lengthOf, listOf, [&](const void *data, size_t size) { return writer.append(data, size); });
+        if (!written || !writer.finish(totalBytes)) return __writeError(fd, direct ? "O_DIRECT write failed" : "writev failed");
+
+        if (::close(fd) != 0) return __writeError(-1, "close failed");
+        return Response<void>();
+    }
+
+#else
+
+    template <typename LengthOf, typename ListOf>
+    Response<void> __writeBatched(const std::string& filename, int V, LengthOf lengthOf, ListOf listOf, uint64_t,
+                                  const WriteOptions& options) {
+        TRACE_SPAN("graph.write");
+        std::vector<char> staging(std::max<size_t>(options.bufferBytes, 1));
+        std::ofstream out;
+        out.rdbuf()->pubsetbuf(staging.data(), staging.size());
+        out.open(filename, std::ios::binary | std::ios::trunc);
+        if (!out) return Response<void>(ErrorCode::OPEN_FAILED, "Error: Could not open output file for writing");
+
+        __forEachChunk(V, lengthOf, listOf, [&](const void *data, size_t size) {
+            out.write(static_cast<const char*>(data), size);
+            return static_cast<bool>(out);
+        });
+        out.close();
+        if (!out) return Response<void>(ErrorCode::WRITE_FAILED, "Error: Could not write output file");
+
+        return Response<void>();
+    }
+
+#endif
+
+    /// @brief Size of the file: header, one length per vertex and every half-edge
+    uint64_t __fileBytes(int V, uint64_t halfEdges) {
+        return sizeof(int) * (1 + static_cast<uint64_t>(V) + halfEdges);
+    }
+
+    Response<void> __writeGraphBatched(const std::string& filename, const Graph& graph, const WriteOptions& options, uint64_t& bytes) {
+        int V = static_cast<int>(graph.adj.size());
+        uint64_t halfEdges = 0;
+        for (const auto& neighbours : graph.adj) halfEdges += neighbours.size();
+
+        bytes = __fileBytes(V, halfEdges);
+        return __writeBatched(filename, V, [&](int v) { return static_cast<int>(graph.adj[v].size()); },
+                              [&](int v) { return graph.adj[v].data(); }, bytes, options);
+    }
+
+    Response<void> __writeGraphBatched(const std::string& filename, const CsrGraph& graph, const WriteOptions& options, uint64_t& bytes) {
+        bytes = __fileBytes(graph.V, graph.neighbourList.size());
+        return __writeBatched(filename, graph.V, [&](int v) { return graph.getEdgeQuantity(v); },
+                              [&](int v) { return graph.neighbourList.data() + graph.offsets[v]; }, bytes, options);
+    }
+
+    Response<void> writeGraphBatched(const std::string& filename, const Graph& graph, const WriteOptions& options) {
+        uint64_t bytes;
+        return __writeGraphBatched(filename, graph, options, bytes);
+    }
+
+    Response<void> writeGraphBatched(const std::string& filename, const CsrGraph& graph, const WriteOptions& options) {
+        uint64_t bytes;
+        return __writeGraphBatched(filename, graph, options, bytes);
+    }
+
+    template <typename G>
+    TimedResponse<void> __timedWriteGraphBatched(const std::string& filename, const G& graph, const WriteOptions& options) {
+        std::chrono::steady_clock::time_point begin, end;
+        uint64_t bytes = 0;
+
+        begin = std::chrono::steady_clock::now();
+        Response<void> res = __writeGraphBatched(filename, graph, options, bytes);
+        end = std::chrono::steady_clock::now();
+        if (!res.isOk()) return TimedResponse<void>(res.code, std::move(res.message), 0);
+
+        TimedResponse<void> timed(__getDuration(begin, end));
+        double seconds = std::chrono::duration<double>(end - begin).count();
+        timed.bytes = bytes;
+        timed.bytesPerSecond = seconds > 0 ? bytes / seconds : 0;
+        return timed;
     }
 
+    TimedResponse<void> timedWriteGraphBatched(const std::string& filename, const Graph& graph, const WriteOptions& options) {
+        return __timedWriteGraphBatched(filename, graph, options);
+    }
+
+    TimedResponse<void> timedWriteGraphBatched(const std::string& filename, const CsrGraph& graph, const WriteOptions& options) {
+        return __timedWriteGraphBatched(filename, graph, options);
+    }
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 
 #include "graph.hpp"
+#include "csr_graph.hpp"
 #include "response_struct.hpp"
 
 #include <stdio.h>
@@ -59,6 +60,18 @@ namespace graphtext {
     Graph read_graph_from_file(std::ifstream &file);
 
     void writeToFile(const Graph& graph, std::ofstream& outFile);
+
+
+    /**
+     * @brief Reads an undirected edge list ("u v" per line) through the bulk CSR builder
+     *
+     * Lines starting with '#' or '%' are ignored. The vertex quantity is the highest
+     * id found plus one. Repeated edges and self-loops are dropped.
+     *
+     * @param file The input file stream
+     * @return Response<Graph> The canonical graph, or an error message on invalid lines
+     */
+    Response<Graph> read_edge_list(std::ifstream &file);
     
 }
 
@@ -73,10 +86,37 @@ namespace graphformat {
     Response<void> __writeToFileStream(const Graph& graph, std::ofstream& outFile);
 
     long __getDuration(std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end);
+
+    // The whole capacity of ioBuffer is used as stream buffer, an empty vector keeps the default one
     Response<Graph> readGraphFromFile(const std::string& filename, std::vector<char>& ioBuffer);
     TimedResponse<Graph> timedReadGraphFromFile(const std::string& filename, std::vector<char>& ioBuffer);
     Response<void> writeGraphToFile(const std::string& filename, std::vector<char>& ioBuffer, const Graph &graph);
     TimedResponse<void> timedWriteGraphToFile(const std::string& filename, std::vector<char>& ioBuffer, const Graph &graph);
+
+
+    struct WriteOptions {
+        bool direct = false;                  // O_DIRECT, bypasses the page cache (falls back when unsupported)
+        bool preallocate = true;              // fallocate the final size before writing
+        size_t bufferBytes = size_t(4) << 20; // Staging buffer of the lengths and short lists
+    };
+
+    /**
+     * @brief Writes a graph with a few large writev calls, on the same layout of writeGraphToFile
+     *
+     * Lengths and short lists are copied into a staging buffer of `bufferBytes`, written once
+     * full, so a file takes about size / bufferBytes calls. Lists of 64KB or more are not
+     * copied: they go straight from the graph on the same writev as the staged bytes before
+     * them. With `direct` everything is staged (O_DIRECT needs aligned addresses and sizes)
+     * and the padding of the last block is truncated at the end.
+     *
+     * Outside Linux it falls back to an ofstream buffered by `bufferBytes`.
+     */
+    Response<void> writeGraphBatched(const std::string& filename, const Graph& graph, const WriteOptions& options = WriteOptions());
+    Response<void> writeGraphBatched(const std::string& filename, const CsrGraph& graph, const WriteOptions& options = WriteOptions());
+
+    /// @brief writeGraphBatched reporting bytes and bytes/s
+    TimedResponse<void> timedWriteGraphBatched(const std::string& filename, const Graph& graph, const WriteOptions& options = WriteOptions());
+    TimedResponse<void> timedWriteGraphBatched(const std::string& filename, const CsrGraph& graph, const WriteOptions& options = WriteOptions());
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,51 @@
+#ifndef GRAPH_TRAITS_HPP
+#define GRAPH_TRAITS_HPP
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+
+/**
+ * @brief Compile-time description of a graph instantiation
+ *
+ * Graph, tarjan, the naive engine and the Eulerian engines are templates over these
+ * traits. Every choice is resolved with `if constexpr`, so an instantiation carries no
+ * runtime branch for the options it does not use.
+ *
+ * @tparam VertexT Signed vertex id type, also used for Tarjan timestamps (-1 marks unvisited)
+ * @tparam EdgeT Signed type wide enough to count every half-edge
+ * @tparam IsMultigraph Parallel edges are allowed. When false, repeated insertions are ignored
+ * @tparam IsDirected pushEdge/addEdge only create u -> v. Bridge and Eulerian engines require undirected graphs
+ */
+template <typename VertexT, typename EdgeT, bool IsMultigraph, bool IsDirected>
+struct GraphTraits {
+    using Vertex = VertexT;
+    using EdgeIndex = EdgeT;
+
+    static constexpr bool multigraph = IsMultigraph;
+    static constexpr bool directed = IsDirected;
+};
+
+
+/// @brief Layout used by the whole project (`Graph`), undirected multigraph with int ids
+using DefaultGraphTraits = GraphTraits<int, int, true, false>;
+
+/// @brief Graphs up to 32767 vertices, halves the bandwidth of lists and Tarjan arrays
+using SmallGraphTraits = GraphTraits<int16_t, int32_t, true, false>;
+
+/// @brief Graphs above 2^31 half-edges or vertices
+using WideGraphTraits = GraphTraits<int64_t, int64_t, true, false>;
+
+/// @brief Undirected graph without parallel edges
+using SimpleGraphTraits = GraphTraits<int, int, false, false>;
+
+/// @brief Directed multigraph, only the Graph container is instantiated for it
+using DirectedGraphTraits = GraphTraits<int, int, true, true>;
+
+
+template <typename Vertex>
+using BasicEdgeVector = std::vector<std::pair<Vertex, Vertex>>;
+
+
+#endif  // GRAPH_TRAITS_HPP
@@ -6,6 +6,8 @@
 #include "randomizer.hpp"
 #include "test.hpp"
 
+#include <cerrno>
+#include <cstdlib>
 #include <functional>
 #include <vector>
 #include <iostream>
@@ -20,6 +22,22 @@ void outputGraph(const Graph& graph, const std::string& str);
 
 
 
+/// @brief Decimal integer in [minimum, maximum], the whole text must be the number (no sign)
+bool parseCount(const char *text, unsigned long minimum, unsigned long maximum, unsigned long& value) {
+    if (text == nullptr || *text < '0' || *text > '9') return false;
+    char *end = nullptr;
+    errno = 0;
+    value = std::strtoul(text, &end, 10);
+    return errno == 0 && *end == '\0' && value >= minimum && value <= maximum;
+}
+
+void printUsage(std::ostream& out) {
+    out << "Usage:" << std::endl
+        << "  MyProject --batch SPEC [RESULT_FILE [THREADS]]" << std::endl
+        << "  MyProject --stream-bridges FILE" << std::endl
+        << "  MyProject --external-bridges FILE [CACHE_MB]" << std::endl;
+}
+
 long getDuration(std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end) {
     return std::chrono::duration_cast<std::chrono::microseconds> (end - begin).count();
 }
@@ -44,11 +62,10 @@ int ioTest(Graph& graph) {
     end = std::chrono::steady_clock::now();
 
     if (!writeResult.isOk()) {
-        std::cerr << writeResult.message << std::endl;
+        std::cerr << writeResult.describe() << std::endl;
         return -1;
     } 
     std::cout << "write time: " << getDuration(begin,end) << "[microsseconds]" << std::endl;
-    ioBuffer.clear();
 
 
     // Graph Reader
@@ -57,12 +74,20 @@ int ioTest(Graph& graph) {
     end = std::chrono::steady_clock::now();
 
     if (!result.isOk()) {
-        std::cerr << result.message << std::endl;
+        std::cerr << result.describe() << std::endl;
         return -1;
     }
 
     std::cout << "read time: " << getDuration(begin,end) << "[microsseconds]" << std::endl;
-    ioBuffer.clear();
+
+
+    // Canonical lists: the comparison below matches them directly instead of sorting copies
+    begin = std::chrono::steady_clock::now();
+    graph.canonicalize();
+    result.value.canonicalize();
+    end = std::chrono::steady_clock::now();
+
+    std::cout << "canonicalize time: " << getDuration(begin,end) << "[microsseconds]" << std::endl;
 
 
     // Check results
@@ -232,19 +257,45 @@ Response<Graph> readGraph(const string& filename) {
     end = std::chrono::steady_clock::now();
 
     std::cout << "Read time: " << getDuration(begin,end) << "[microsseconds]" << std::endl;
-    ioBuffer.clear();
 
     return result;
 }
 
-int main() {
+int main(int argc, char **argv) {
+    // MyProject --batch SPEC [RESULT_FILE [THREADS]]: folder, glob or manifest of .graph files
+    if (argc > 2 && string(argv[1]) == "--batch") {
+        string resultFile = argc > 3 ? argv[3] : "batch_results.csv";
+        unsigned long threads = 0;  // 0 uses every core
+        if (argc > 4 && !parseCount(argv[4], 0, 1024, threads)) {
+            std::cerr << "Invalid THREADS: " << argv[4] << std::endl;
+            printUsage(std::cerr);
+            return 1;
+        }
+        return test::executeBatch(argv[2], resultFile, static_cast<unsigned>(threads)) == 0 ? 0 : 1;
+    }
+
+    // MyProject --stream-bridges FILE: one sequential pass over a .graph file, O(V) memory
+    if (argc > 2 && string(argv[1]) == "--stream-bridges") {
+        return test::executeStreaming(argv[2]) == 0 ? 0 : 1;
+    }
+
+    // MyProject --external-bridges FILE [CACHE_MB]: adjacency read from disk through a block cache
+    if (argc > 2 && string(argv[1]) == "--external-bridges") {
+        unsigned long cacheMegabytes = 64;
+        if (argc > 3 && !parseCount(argv[3], 1, 1ul << 20, cacheMegabytes)) {  // At most 1 TB, the byte count never overflows
+            std::cerr << "Invalid CACHE_MB: " << argv[3] << std::endl;
+            printUsage(std::cerr);
+            return 1;
+        }
+        return test::executeExternal(argv[2], static_cast<size_t>(cacheMegabytes)) == 0 ? 0 : 1;
+    }
 
     int quantidadeVertices = 2000;
     for(int i = 0; i < 20; i++) {
         cout << "I: " << i << endl;
         Response<Graph> graph = generateEulerianGraph(quantidadeVertices, 0);
         if (!graph.isOk()) {
-            std::cerr << graph.message << std::endl;
+            std::cerr << graph.describe() << std::endl;
             return -1;
         }
         cout << "Quantity of Edges: " << endl << graph.value.getTotalQuantityEdges() << endl;
@@ -1,9 +1,12 @@
 #include "naive.hpp"
 #include "graph.hpp"
+#include "trace.hpp"
+#include "scheduler.hpp"
 
 #include <vector>
 #include <iostream>
 #include <chrono>
+#include <algorithm>
 
 
 /**
@@ -16,17 +19,94 @@
  * @param g The graph object where the edge is located.
  * @return true if the edge (u, v) is a bridge, false otherwise.
  */
-bool isBridge(int u, int v, Graph &g)
+template <typename Traits>
+bool isBridge(typename Traits::Vertex u, typename Traits::Vertex v, BasicGraph<Traits> &g)
 {
+    algostats::NoStats stats;
+    return isBridge(u, v, g, stats);
+}
+
+template <typename Traits, typename Stats>
+bool isBridge(typename Traits::Vertex u, typename Traits::Vertex v, BasicGraph<Traits> &g, Stats& stats)
+{
+    stats.oracleCall();
+    if constexpr (Traits::multigraph) {
+        // A parallel copy keeps u and v connected, and removeEdge would drop every copy
+        if (std::count(g.adj[u].begin(), g.adj[u].end(), v) > 1) return false;
+    }
+
     g.removeEdge(u, v);
 
-    bool bridge = !(g.isConnected());
+    bool bridge = !(g.isConnected(stats));
 
     g.addEdge(u, v);
 
     return bridge;
 }
 
+// Below this amount of edges the slices cost more than the searches themselves
+const size_t PARALLEL_NAIVE_EDGES = 256;
+
+/**
+ * @brief executeNaive on the shared scheduler, same answer in the same order
+ *
+ * The graph is only read: instead of removing (u, v), each check searches from u without
+ * crossing that edge, stopping as soon as v is reached. Removing an edge of a connected
+ * graph disconnects it exactly when v becomes unreachable from u. A disconnected graph
+ * stays disconnected, so there every edge without a parallel copy is reported, as the
+ * sequential loop does.
+ */
+template <typename Traits>
+BasicEdgeVector<typename Traits::Vertex> __executeNaiveParallel(const BasicGraph<Traits> &g, const BasicEdgeVector<typename Traits::Vertex>& edges)
+{
+    using Vertex = typename Traits::Vertex;
+    const bool connected = g.isConnected();
+
+    std::vector<char> bridge(edges.size(), 0);
+    sched::parallelFor(0, edges.size(), std::max<size_t>(16, edges.size() / (sched::threadCount() * 8)), [&](size_t first, size_t last) {
+        std::vector<uint32_t> mark(g.V, 0);  // Stamp of the last search that reached each vertex
+        std::vector<Vertex> stack;
+
+        for (size_t e = first; e < last; e++) {
+            const Vertex u = edges[e].first, v = edges[e].second;
+            if constexpr (Traits::multigraph) {
+                if (std::count(g.adj[u].begin(), g.adj[u].end(), v) > 1) continue;
+            }
+            if (!connected) {
+                bridge[e] = 1;
+                continue;
+            }
+
+            const uint32_t stamp = static_cast<uint32_t>(e - first + 1);
+            bool reached = false;
+            stack.assign(1, u);
+            mark[u] = stamp;
+            while (!stack.empty() && !reached) {
+                Vertex x = stack.back();
+                stack.pop_back();
+                for (Vertex y : g.adj[x]) {
+                    if ((x == u && y == v) || (x == v && y == u)) continue;
+                    if (y == v) {
+                        reached = true;
+                        break;
+                    }
+                    if (mark[y] != stamp) {
+                        mark[y] = stamp;
+                        stack.push_back(y);
+                    }
+                }
+            }
+            bridge[e] = !reached;
+        }
+    });
+
+    BasicEdgeVector<Vertex> bridges;
+    for (size_t e = 0; e < edges.size(); e++) {
+        if (bridge[e]) bridges.push_back(edges[e]);
+    }
+    return bridges;
+}
+
 /**
  * @brief Identifies all bridges in the graph using a naive approach.
  *
@@ -36,23 +116,40 @@ bool isBridge(int u, int v, Graph &g)
  * @param g The graph object to check for bridges.
  * @return A vector of pairs representing the bridges found in the graph.
  */
-EdgeVector executeNaive(Graph &g)
+template <typename Traits>
+BasicEdgeVector<typename Traits::Vertex> executeNaive(BasicGraph<Traits> &g)
 {
-    EdgeVector bridges; // Vector to store the bridges found in the graph
-    EdgeVector edges;   // Vector to store all edges before removing any
+    algostats::NoStats stats;
+    return executeNaive(g, stats);
+}
+
+template <typename Traits, typename Stats>
+BasicEdgeVector<typename Traits::Vertex> executeNaive(BasicGraph<Traits> &g, Stats& stats)
+{
+    static_assert(!Traits::directed, "Bridges are only defined for undirected graphs");
+    using Vertex = typename Traits::Vertex;
+    TRACE_SPAN("naive");
+
+    BasicEdgeVector<Vertex> bridges; // Vector to store the bridges found in the graph
+    BasicEdgeVector<Vertex> edges;   // Vector to store all edges before removing any
 
     // Collect all edges from the graph
-    for (int u = 0; u < g.V; u++) { 
-        for (int v : g.adj[u]) {    
+    for (Vertex u = 0; u < g.V; u++) { 
+        for (Vertex v : g.adj[u]) {    
             if (u < v) { // Avoid duplicate edges for undirected graph (e.g., (u,v) and (v,u))
                 edges.push_back({u, v});
             }
         }
     }
 
+    // Counting policies are not thread-safe, they keep the sequential loop
+    if constexpr (!Stats::enabled) {
+        if (edges.size() >= PARALLEL_NAIVE_EDGES && sched::threadCount() > 1) return __executeNaiveParallel(g, edges);
+    }
+
     // Process each edge without modifying the list during iteration
     for (auto [u, v] : edges) {
-        if (isBridge(u, v, g)) {
+        if (isBridge(u, v, g, stats)) {
             bridges.push_back({u, v});
         }
     }
@@ -61,3 +158,15 @@ EdgeVector executeNaive(Graph &g)
 }
 
 
+#define INSTANTIATE_NAIVE(Traits) \
+    template bool isBridge<Traits>(typename Traits::Vertex u, typename Traits::Vertex v, BasicGraph<Traits> &g); \
+    template bool isBridge<Traits, algostats::NoStats>(typename Traits::Vertex u, typename Traits::Vertex v, BasicGraph<Traits> &g, algostats::NoStats &stats); \
+    template bool isBridge<Traits, algostats::CountingStats>(typename Traits::Vertex u, typename Traits::Vertex v, BasicGraph<Traits> &g, algostats::CountingStats &stats); \
+    template BasicEdgeVector<typename Traits::Vertex> executeNaive<Traits>(BasicGraph<Traits> &g); \
+    template BasicEdgeVector<typename Traits::Vertex> executeNaive<Traits, algostats::NoStats>(BasicGraph<Traits> &g, algostats::NoStats &stats); \
+    template BasicEdgeVector<typename Traits::Vertex> executeNaive<Traits, algostats::CountingStats>(BasicGraph<Traits> &g, algostats::CountingStats &stats);
+
+INSTANTIATE_NAIVE(DefaultGraphTraits)
+INSTANTIATE_NAIVE(SmallGraphTraits)
+INSTANTIATE_NAIVE(WideGraphTraits)
+INSTANTIATE_NAIVE(SimpleGraphTraits)
@@ -3,15 +3,25 @@
 
 // Graph library import
 #include "graph.hpp"
+#include "algorithm_stats.hpp"
 
 
 #include <iostream>
 #include <vector>
 
 /// @brief verifies if a pair of vertices is a bridge
-EdgeVector executeNaive(Graph &g);
+template <typename Traits>
+BasicEdgeVector<typename Traits::Vertex> executeNaive(BasicGraph<Traits> &g);
 
-bool isBridge(int u, int v);
+/// @brief executeNaive() reporting to a statistics policy, every isBridge is an oracle call (see algorithm_stats.hpp)
+template <typename Traits, typename Stats>
+BasicEdgeVector<typename Traits::Vertex> executeNaive(BasicGraph<Traits> &g, Stats& stats);
 
+template <typename Traits>
+bool isBridge(typename Traits::Vertex u, typename Traits::Vertex v, BasicGraph<Traits> &g);
 
-#endif  // NAIVE_HPP
\ No newline at end of file
+template <typename Traits, typename Stats>
+bool isBridge(typename Traits::Vertex u, typename Traits::Vertex v, BasicGraph<Traits> &g, Stats& stats);
+
+
+#endif  // NAIVE_HPP
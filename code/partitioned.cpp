@@ -0,0 +1,266 @@
+#include "partitioned.hpp"
+#include "graph.hpp"
+#include "csr_graph.hpp"
+#include "trace.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <utility>
+
+
+namespace partitioned {
+
+    //---- Métodos auxiliares ----//
+
+    /// @brief Builds the local CSR arrays from pairs of local ids, keeping parallel edges
+    void __buildLocal(int32_t n, const std::vector<int32_t>& ends, std::vector<uint64_t>& offsets, std::vector<int>& neighbours) {
+        offsets.assign(n + 1, 0);
+        for (int32_t end : ends) offsets[end + 1]++;
+        for (int32_t v = 0; v < n; v++) offsets[v + 1] += offsets[v];
+
+        neighbours.resize(ends.size());
+        std::vector<uint64_t> position(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < ends.size(); i += 2) {
+            neighbours[position[ends[i]]++] = ends[i + 1];
+            neighbours[position[ends[i + 1]]++] = ends[i];
+        }
+    }
+
+    /**
+     * @brief Worker side: local bridges and local 2-edge-connected components of one partition
+     *
+     * Request: int32 n, uint64 m, m pairs of int32 local ids
+     * Reply: int32 components, n int32 labels, uint64 b, b pairs of int32 local ids
+     *
+     * Sequential on purpose, forked workers cannot use the shared scheduler.
+     */
+    Response<void> __worker(unsigned, transport::Endpoint& coordinator) {
+        Response<transport::Message> request = coordinator.receive();
+        if (!request.isOk()) return Response<void>(request.code, std::move(request.message));
+
+        transport::Reader reader(request.value);
+        int32_t n = 0;
+        uint64_t m = 0;
+        if (!reader.read(n) || !reader.read(m) || n < 0 || m > request.value.size()) {
+            return Response<void>(ErrorCode::INVALID_FORMAT, "Error: Malformed partition request");
+        }
+        std::vector<int32_t> ends(2 * m);
+        if (!reader.read(ends.data(), ends.size()) || !reader.done()) {
+            return Response<void>(ErrorCode::INVALID_FORMAT, "Error: Malformed partition request");
+        }
+        for (int32_t end : ends) {
+            if (end < 0 || end >= n) return Response<void>(ErrorCode::INVALID_FORMAT, "Error: Partition edge out of range");
+        }
+
+        std::vector<uint64_t> offsets;
+        std::vector<int> neighbours;
+        __buildLocal(n, ends, offsets, neighbours);
+        CsrView local(n, offsets.data(), neighbours.data());
+
+        EdgeVector bridges = tarjanAllComponents(local);
+        std::vector<int32_t> labels(n);
+        int32_t components = labelTwoEdgeComponents(local, bridges, labels.data());
+
+        transport::Message reply;
+        reply.reserve(sizeof(int32_t) * (1 + n + 2 * bridges.size()) + sizeof(uint64_t));
+        transport::append(reply, components);
+        transport::append(reply, labels.data(), labels.size());
+        transport::append(reply, static_cast<uint64_t>(bridges.size()));
+        for (const auto& [u, v] : bridges) {
+            transport::append(reply, static_cast<int32_t>(u));
+            transport::append(reply, static_cast<int32_t>(v));
+        }
+        return coordinator.send(std::move(reply));
+    }
+
+    uint64_t __mix(uint64_t x) {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+
+    //---- Métodos públicos ----//
+
+    const char* partitionerToString(Partitioner partitioner) {
+        switch (partitioner) {
+            case Partitioner::HASH: return "hash";
+            case Partitioner::BFS: return "bfs";
+        }
+        return "unknown";
+    }
+
+    template <typename G>
+    std::vector<int> partition(const G& graph, unsigned parts, Partitioner partitioner) {
+        const int n = graph.getVertexQuantity();
+        parts = std::max(parts, 1u);
+        std::vector<int> part(n, -1);
+
+        if (partitioner == Partitioner::HASH) {
+            for (int v = 0; v < n; v++) part[v] = static_cast<int>(__mix(static_cast<uint64_t>(v)) % parts);
+            return part;
+        }
+
+        // Breadth-first growth: a partition takes vertices in visiting order until it is full
+        const int capacity = static_cast<int>((static_cast<long long>(n) + parts - 1) / parts);
+        int current = 0, filled = 0;
+        auto assign = [&](int v) {
+            part[v] = current;
+            if (++filled == capacity && current + 1 < static_cast<int>(parts)) {
+                current++;
+                filled = 0;
+            }
+        };
+
+        std::vector<int> queue;
+        queue.reserve(n);
+        for (int root = 0; root < n; root++) {
+            if (part[root] != -1) continue;
+            queue.clear();
+            queue.push_back(root);
+            assign(root);
+            for (size_t head = 0; head < queue.size(); head++) {
+                for (int w : graph.neighbours(queue[head])) {
+                    if (part[w] != -1) continue;
+                    assign(w);
+                    queue.push_back(w);
+                }
+            }
+        }
+        return part;
+    }
+
+    template <typename G>
+    Response<EdgeVector> findBridges(const G& graph, const PartitionOptions& options, PartitionStats *stats) {
+        TRACE_SPAN("partitioned");
+        if (options.parts == 0) return Response<EdgeVector>(ErrorCode::INVALID_ARGUMENT, "Error: At least one partition is needed");
+
+        const int n = graph.getVertexQuantity();
+        const unsigned parts = options.parts;
+        std::vector<int> part = partition(graph, parts, options.partitioner);
+
+        // Local ids: position of each vertex on the member list of its partition
+        std::vector<std::vector<int>> members(parts);
+        std::vector<int32_t> localId(n);
+        for (int v = 0; v < n; v++) {
+            localId[v] = static_cast<int32_t>(members[part[v]].size());
+            members[part[v]].push_back(v);
+        }
+
+        std::vector<std::vector<int32_t>> localEnds(parts);
+        EdgeVector cut;
+        for (int v = 0; v < n; v++) {
+            for (int w : graph.neighbours(v)) {
+                if (v >= w) continue;  // Each copy of an edge once, self-loops skipped
+                if (part[v] == part[w]) {
+                    localEnds[part[v]].push_back(localId[v]);
+                    localEnds[part[v]].push_back(localId[w]);
+                } else {
+                    cut.emplace_back(v, w);
+                }
+            }
+        }
+
+        std::unique_ptr<transport::Transport> channel = transport::makeTransport(options.transport);
+        Response<void> started = channel->start(parts, __worker);
+        if (!started.isOk()) return Response<EdgeVector>(started.code, std::move(started.message));
+
+        for (unsigned p = 0; p < parts; p++) {
+            transport::Message request;
+            request.reserve(sizeof(int32_t) * (1 + localEnds[p].size()) + sizeof(uint64_t));
+            transport::append(request, static_cast<int32_t>(members[p].size()));
+            transport::append(request, static_cast<uint64_t>(localEnds[p].size() / 2));
+            transport::append(request, localEnds[p].data(), localEnds[p].size());
+            std::vector<int32_t>().swap(localEnds[p]);
+
+            Response<void> sent = channel->send(p, std::move(request));
+            if (!sent.isOk()) {
+                channel->finish();
+                return Response<EdgeVector>(sent.code, std::move(sent.message));
+            }
+        }
+
+        // Merge graph: one vertex per local component, local bridges and cut edges between them
+        std::vector<int> component(n);
+        EdgeVector mergeEdges, origins;
+        int mergeVertices = 0;
+        for (unsigned p = 0; p < parts; p++) {
+            Response<transport::Message> reply = channel->receive(p);
+            if (!reply.isOk()) {
+                Response<void> finished = channel->finish();
+                return finished.isOk() ? Response<EdgeVector>(reply.code, std::move(reply.message))
+                                       : Response<EdgeVector>(finished.code, std::move(finished.message));
+            }
+
+            transport::Reader reader(reply.value);
+            int32_t components = 0;
+            uint64_t bridgeQuantity = 0;
+            std::vector<int32_t> labels(members[p].size());
+            bool valid = reader.read(components) && reader.read(labels.data(), labels.size()) && reader.read(bridgeQuantity)
+                         && bridgeQuantity <= reply.value.size();
+            std::vector<int32_t> bridgeEnds(valid ? 2 * bridgeQuantity : 0);
+            valid = valid && reader.read(bridgeEnds.data(), bridgeEnds.size()) && reader.done();
+            for (int32_t label : labels) valid = valid && label >= 0 && label < components;
+            for (int32_t end : bridgeEnds) valid = valid && end >= 0 && static_cast<size_t>(end) < members[p].size();
+            if (!valid) {
+                channel->finish();
+                return Response<EdgeVector>(ErrorCode::INVALID_FORMAT, "Error: Malformed reply from partition " + std::to_string(p));
+            }
+
+            for (size_t i = 0; i < labels.size(); i++) component[members[p][i]] = mergeVertices + labels[i];
+            for (size_t i = 0; i < bridgeEnds.size(); i += 2) {
+                int u = members[p][bridgeEnds[i]], w = members[p][bridgeEnds[i + 1]];
+                mergeEdges.emplace_back(component[u], component[w]);
+                origins.emplace_back(u, w);
+            }
+            mergeVertices += components;
+        }
+
+        Response<void> finished = channel->finish();
+        if (!finished.isOk()) return Response<EdgeVector>(finished.code, std::move(finished.message));
+
+        for (const auto& [u, w] : cut) {
+            mergeEdges.emplace_back(component[u], component[w]);
+            origins.emplace_back(u, w);
+        }
+
+        if (stats != nullptr) {
+            stats->cutEdges = cut.size();
+            stats->mergeVertices = mergeVertices;
+            stats->mergeEdges = mergeEdges.size();
+            stats->bytesSent = channel->bytesSent();
+            stats->bytesReceived = channel->bytesReceived();
+        }
+
+        // A bridge of the merge graph has no parallel copy, so its (min, max) key finds its origin
+        CsrGraph merge = csr::buildSymmetric(mergeVertices, mergeEdges);
+        EdgeVector mergeBridges = tarjanAllComponents(merge);
+
+        auto key = [&](size_t i) { return std::make_pair(std::min(mergeEdges[i].first, mergeEdges[i].second),
+                                                         std::max(mergeEdges[i].first, mergeEdges[i].second)); };
+        std::vector<size_t> order(mergeEdges.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return key(a) < key(b); });
+
+        EdgeVector bridges;
+        bridges.reserve(mergeBridges.size());
+        for (const auto& bridge : mergeBridges) {
+            auto found = std::lower_bound(order.begin(), order.end(), bridge, [&](size_t i, const std::pair<int, int>& target) { return key(i) < target; });
+            const auto& [u, w] = origins[*found];
+            bridges.emplace_back(std::min(u, w), std::max(u, w));
+        }
+        std::sort(bridges.begin(), bridges.end());
+        return Response<EdgeVector>(std::move(bridges));
+    }
+
+
+#define INSTANTIATE_PARTITIONED(G) \
+    template std::vector<int> partition<G>(const G& graph, unsigned parts, Partitioner partitioner); \
+    template Response<EdgeVector> findBridges<G>(const G& graph, const PartitionOptions& options, PartitionStats *stats);
+
+    INSTANTIATE_PARTITIONED(Graph)
+    INSTANTIATE_PARTITIONED(CsrGraph)
+}
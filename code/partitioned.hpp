@@ -0,0 +1,72 @@
+#ifndef PARTITIONED_HPP
+#define PARTITIONED_HPP
+
+#include <cstddef>
+#include <vector>
+#include "tarjan.hpp"
+#include "transport.hpp"
+#include "response_struct.hpp"
+
+
+/**
+ * @brief Bridges of a graph split over several workers that only talk through messages
+ *
+ * 1. The vertex set is cut into `parts` partitions. An edge with both ends on the same
+ *    partition is local, the others are cut edges
+ * 2. Worker p receives only its local edges (renumbered to [0 ... n_p-1]) and replies with
+ *    its local bridges and the 2-edge-connected component of each of its vertices
+ * 3. The coordinator contracts every local component to one vertex. The result (a bridge
+ *    forest per partition plus the cut edges) is the bridge tree merge graph: its bridges
+ *    are exactly the bridges of the whole graph, and cycles that cross partitions are
+ *    resolved there
+ *
+ * Step 3 is exact because a local component is 2-edge-connected inside the whole graph as
+ * well, and contracting a 2-edge-connected subgraph neither creates nor removes bridges
+ * elsewhere. The merge graph has one vertex per local component, so it stays small when the
+ * partitions follow the structure of the graph.
+ *
+ * Workers run on a transport::Transport (threads or forked processes). The coordinator
+ * still reads the whole graph; workers only ever hold their own partition.
+ */
+namespace partitioned {
+
+    enum class Partitioner {
+        HASH,   // Mixed vertex id modulo parts: balanced, but most edges end up cut
+        BFS     // Partitions grown in breadth-first order up to n/parts vertices: few cut edges on local graphs
+    };
+
+    const char* partitionerToString(Partitioner partitioner);
+
+    struct PartitionOptions {
+        unsigned parts = 4;
+        Partitioner partitioner = Partitioner::BFS;
+        transport::Kind transport = transport::Kind::THREADS;
+    };
+
+    struct PartitionStats {
+        size_t cutEdges = 0;
+        size_t mergeVertices = 0;   // Local components over every partition
+        size_t mergeEdges = 0;      // Local bridges plus cut edges
+        size_t bytesSent = 0;       // Coordinator to workers
+        size_t bytesReceived = 0;
+    };
+
+    /// @brief Partition of each vertex, on range [0 ... parts-1]
+    template <typename G>
+    std::vector<int> partition(const G& graph, unsigned parts, Partitioner partitioner);
+
+    /**
+     * @brief Bridges of every connected component, as (min, max) pairs in sorted order
+     *
+     * Same set as tarjanAllComponents(graph), and as tarjan(graph) once normalized on a connected
+     * graph. Self-loops never take part in a bridge and are not sent to the workers.
+     *
+     * @param stats Filled with the sizes of the merge and the traffic, when not null
+     */
+    template <typename G>
+    Response<EdgeVector> findBridges(const G& graph, const PartitionOptions& options = PartitionOptions(),
+                                     PartitionStats *stats = nullptr);
+}
+
+
+#endif  // PARTITIONED_HPP
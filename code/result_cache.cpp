@@ -0,0 +1,265 @@
+#include "result_cache.hpp"
+#include "tarjan.hpp"
+#include "eulerian.hpp"
+#include "graph_reader.hpp"
+#include "compressed_graph.hpp"
+#include "csr_graph.hpp"
+#include "xxhash64.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <vector>
+#include <unistd.h>
+
+
+namespace resultcache {
+
+    const char CACHE_MAGIC[8] = {'G', 'B', 'C', 'A', 'C', 'H', 'E', '\0'};
+    const uint32_t CACHE_VERSION = 3;  // Version 1 only held the bridges of the component of vertex 0, version 2 could hold partial walks
+
+    // Fixed size header, followed by offsets, neighbours, bridges, components and path
+    struct __CacheHeader {
+        char magic[8];
+        uint32_t version;
+        int32_t V;
+        uint64_t sourceSize;
+        int64_t sourceTime;
+        uint64_t contentHash;
+        uint64_t halfEdges;
+        uint64_t bridgeQuantity;
+        uint64_t pathLength;
+        int32_t componentQuantity;
+        uint32_t deduped;
+    };
+
+    struct __SourceStamp {
+        uint64_t size = 0;
+        int64_t time = 0;
+    };
+
+
+    //---- Métodos auxiliares ----//
+
+    bool __stampOf(const std::string& filename, __SourceStamp& stamp) {
+        std::error_code error;
+        stamp.size = std::filesystem::file_size(filename, error);
+        if (error) return false;
+        stamp.time = static_cast<int64_t>(std::filesystem::last_write_time(filename, error).time_since_epoch().count());
+        return !error;
+    }
+
+    uint64_t __expectedCacheSize(const __CacheHeader& header) {
+        return sizeof(__CacheHeader)
+            + sizeof(uint64_t) * (static_cast<uint64_t>(header.V) + 1)
+            + sizeof(int) * header.halfEdges
+            + 2 * sizeof(int) * header.bridgeQuantity
+            + sizeof(int) * static_cast<uint64_t>(header.V)
+            + sizeof(int) * header.pathLength;
+    }
+
+    template <typename T>
+    bool __readArray(std::ifstream& in, std::vector<T>& values, uint64_t count) {
+        values.resize(count);
+        in.read(reinterpret_cast<char*>(values.data()), sizeof(T) * count);
+        return static_cast<bool>(in);
+    }
+
+    template <typename T>
+    void __writeArray(std::ofstream& out, const std::vector<T>& values) {
+        out.write(reinterpret_cast<const char*>(values.data()), sizeof(T) * values.size());
+    }
+
+    /// @brief Reads and validates the header, false when the sidecar is missing, corrupted or from another version
+    bool __readHeader(const std::string& cacheFile, __CacheHeader& header) {
+        std::ifstream in(cacheFile, std::ios::binary);
+        if (!in) return false;
+
+        in.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!in) return false;
+        if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header.version != CACHE_VERSION || header.V < 0) {
+            return false;
+        }
+
+        std::error_code error;
+        uint64_t size = std::filesystem::file_size(cacheFile, error);
+        return !error && size == __expectedCacheSize(header);
+    }
+
+    bool __readBody(const std::string& cacheFile, const __CacheHeader& header, GraphResults& results) {
+        std::ifstream in(cacheFile, std::ios::binary);
+        if (!in) return false;
+        in.seekg(sizeof(__CacheHeader));
+
+        std::vector<int> bridgeEnds;
+        results.graph.V = header.V;
+        results.graph.deduped = header.deduped != 0;
+        bool ok = __readArray(in, results.graph.offsets, static_cast<uint64_t>(header.V) + 1)
+               && __readArray(in, results.graph.neighbourList, header.halfEdges)
+               && __readArray(in, bridgeEnds, 2 * header.bridgeQuantity)
+               && __readArray(in, results.components, header.V)
+               && __readArray(in, results.eulerianPath, header.pathLength);
+        if (!ok) return false;
+
+        results.bridges.resize(header.bridgeQuantity);
+        for (uint64_t i = 0; i < header.bridgeQuantity; i++) {
+            results.bridges[i] = {bridgeEnds[2 * i], bridgeEnds[2 * i + 1]};
+        }
+        results.contentHash = header.contentHash;
+        results.componentQuantity = header.componentQuantity;
+        return true;
+    }
+
+    // Distinguishes the temporary files of the threads of one process
+    std::atomic<uint64_t> __temporaryCounter(0);
+
+    /// @brief Writes on a temporary file and renames it, readers never see a partial sidecar
+    ///
+    /// The temporary name is unique per process and call, so concurrent writers never share it
+    bool __writeCache(const std::string& cacheFile, const __SourceStamp& stamp, const GraphResults& results) {
+        __CacheHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        header.version = CACHE_VERSION;
+        header.V = results.graph.V;
+        header.sourceSize = stamp.size;
+        header.sourceTime = stamp.time;
+        header.contentHash = results.contentHash;
+        header.halfEdges = results.graph.neighbourList.size();
+        header.bridgeQuantity = results.bridges.size();
+        header.pathLength = results.eulerianPath.size();
+        header.componentQuantity = results.componentQuantity;
+        header.deduped = results.graph.deduped ? 1 : 0;
+
+        std::vector<int> bridgeEnds;
+        bridgeEnds.reserve(2 * results.bridges.size());
+        for (const auto& [u, v] : results.bridges) {
+            bridgeEnds.push_back(u);
+            bridgeEnds.push_back(v);
+        }
+
+        const std::string temporary = cacheFile + ".tmp." + std::to_string(::getpid()) + "." + std::to_string(__temporaryCounter++);
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (!out) return false;
+
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            __writeArray(out, results.graph.offsets);
+            __writeArray(out, results.graph.neighbourList);
+            __writeArray(out, bridgeEnds);
+            __writeArray(out, results.components);
+            __writeArray(out, results.eulerianPath);
+
+            out.close();
+            if (!out) {
+                std::remove(temporary.c_str());
+                return false;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporary, cacheFile, error);
+        return !error;
+    }
+
+    /// @brief Only the stamp changed (file touched or copied), the content is the same
+    bool __refreshStamp(const std::string& cacheFile, __CacheHeader header, const __SourceStamp& stamp) {
+        header.sourceSize = stamp.size;
+        header.sourceTime = stamp.time;
+
+        std::fstream out(cacheFile, std::ios::binary | std::ios::in | std::ios::out);
+        if (!out) return false;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        return static_cast<bool>(out);
+    }
+
+    Response<GraphResults> __computeResults(const std::string& graphFile, uint64_t contentHash) {
+        std::vector<char> ioBuffer(64 * 1024);
+        Response<Graph> read = graphformat::readGraphFromFile(graphFile, ioBuffer);
+        if (!read.isOk()) return Response<GraphResults>(read.code, std::move(read.message));
+
+        GraphResults results;
+        results.contentHash = contentHash;
+        results.graph = CsrGraph::fromGraph(read.value);
+
+        results.bridges = tarjanAllComponents(results.graph);
+
+        results.components.resize(results.graph.V);
+        results.componentQuantity = labelTwoEdgeComponents(results.graph, results.bridges, results.components.data());
+        results.eulerianPath = findEulerianPathHierholzer(CompressedGraph::compress(read.value));
+
+        return Response<GraphResults>(std::move(results));
+    }
+
+
+    //---- Métodos públicos ----//
+
+    std::string cachePathFor(const std::string& graphFile) {
+        return graphFile + ".cache";
+    }
+
+    Response<uint64_t> hashFile(const std::string& filename) {
+        std::ifstream in(filename, std::ios::binary);
+        if (!in) return Response<uint64_t>(ErrorCode::OPEN_FAILED, "Error: Could not open file for hashing");
+
+        std::vector<char> chunk(1 << 20);
+        hashing::Xxh64 state;
+        while (in) {
+            in.read(chunk.data(), chunk.size());
+            state.update(chunk.data(), static_cast<size_t>(in.gcount()));
+        }
+        if (in.bad()) return Response<uint64_t>(ErrorCode::READ_FAILED, "Error: Could not read file for hashing");
+
+        return Response<uint64_t>(state.digest());
+    }
+
+    TimedResponse<GraphResults> loadGraphResults(const std::string& graphFile, const CacheOptions& options) {
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        auto finish = [&](GraphResults&& results) {
+            std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+            return TimedResponse<GraphResults>(graphformat::__getDuration(begin, end), std::move(results));
+        };
+
+        __SourceStamp stamp;
+        if (!__stampOf(graphFile, stamp)) {
+            return TimedResponse<GraphResults>(ErrorCode::OPEN_FAILED, "Error: Could not open input file for reading", 0);
+        }
+
+        const std::string cacheFile = cachePathFor(graphFile);
+        __CacheHeader header;
+        bool cached = __readHeader(cacheFile, header);
+
+        // Fast path, the source was not touched since the sidecar was written
+        if (cached && !options.verifyContent && header.sourceSize == stamp.size && header.sourceTime == stamp.time) {
+            GraphResults results;
+            if (__readBody(cacheFile, header, results)) {
+                results.fromCache = true;
+                return finish(std::move(results));
+            }
+            cached = false;
+        }
+
+        Response<uint64_t> hash = hashFile(graphFile);
+        if (!hash.isOk()) return TimedResponse<GraphResults>(hash.code, std::move(hash.message), 0);
+
+        if (cached && header.contentHash == hash.value) {
+            GraphResults results;
+            if (__readBody(cacheFile, header, results)) {
+                if (options.writeCache) __refreshStamp(cacheFile, header, stamp);
+                results.fromCache = true;
+                return finish(std::move(results));
+            }
+        }
+
+        Response<GraphResults> computed = __computeResults(graphFile, hash.value);
+        if (!computed.isOk()) return TimedResponse<GraphResults>(computed.code, std::move(computed.message), 0);
+
+        if (options.writeCache) __writeCache(cacheFile, stamp, computed.value);
+        return finish(std::move(computed.value));
+    }
+}
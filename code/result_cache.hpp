@@ -0,0 +1,56 @@
+#ifndef RESULT_CACHE_HPP
+#define RESULT_CACHE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "graph.hpp"
+#include "csr_graph.hpp"
+#include "response_struct.hpp"
+
+
+/**
+ * @brief Sidecar cache of a .graph file and everything computed from it
+ *
+ * `<file>.cache` keeps the graph in CSR form (loaded with one read per array) with its
+ * bridges, 2-edge-connected component labels and Eulerian path, keyed by the XXH64 of
+ * the .graph content.
+ *
+ * Invalidation is automatic: the sidecar also stores the size and modification time of
+ * the source. When they match, the cached data is returned without touching the source
+ * (the fast path, microseconds on small graphs). Otherwise the source is hashed, a matching
+ * hash only refreshes the stamp, and a different one recomputes everything.
+ */
+namespace resultcache {
+
+    struct GraphResults {
+        uint64_t contentHash = 0;       // XXH64 of the .graph file
+        CsrGraph graph;
+        EdgeVector bridges;             // (min, max), sorted
+        std::vector<int> components;    // 2-edge-connected component of each vertex
+        int componentQuantity = 0;
+        std::vector<int> eulerianPath;  // Empty when the graph has none
+        bool fromCache = false;         // False when computed on this call
+    };
+
+    struct CacheOptions {
+        bool verifyContent = false;  // Always hash the source, even when the stamp matches
+        bool writeCache = true;      // Stores computed results on the sidecar
+    };
+
+    /// @brief Sidecar path used for a .graph file
+    std::string cachePathFor(const std::string& graphFile);
+
+    /// @brief XXH64 of a whole file, read in 1MB chunks
+    Response<uint64_t> hashFile(const std::string& filename);
+
+    /**
+     * @brief Returns the results of a .graph file, from the sidecar when it is still valid
+     *
+     * Sidecar write failures are not errors, the computed results are returned anyway.
+     */
+    TimedResponse<GraphResults> loadGraphResults(const std::string& graphFile, const CacheOptions& options = CacheOptions());
+}
+
+
+#endif  // RESULT_CACHE_HPP
@@ -0,0 +1,160 @@
+#include "graph_client.hpp"
+
+#include <cstring>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+
+namespace graphserver {
+
+  using graphprotocol::Operation;
+  using graphprotocol::RequestHeader;
+  using graphprotocol::ResponseHeader;
+  using graphprotocol::Status;
+
+
+  //---- Métodos auxiliares ----//
+
+  std::vector<int32_t> __values(const std::string& payload) {
+    std::vector<int32_t> values(payload.size() / sizeof(int32_t));
+    std::memcpy(values.data(), payload.data(), values.size() * sizeof(int32_t));
+    return values;
+  }
+
+
+  //---- Métodos privados ----//
+
+  Response<std::string> GraphClient::call(Operation operation, const std::string& graph, int u, int v) {
+    if (fd < 0) return Response<std::string>(ErrorCode::INVALID_ARGUMENT, "Error: Client is not connected");
+    if (graph.size() > graphprotocol::MAX_NAME_LENGTH) return Response<std::string>(ErrorCode::SIZE_LIMIT, "Error: Graph name too long");
+
+    RequestHeader request;
+    request.requestId = nextId++;
+    request.operation = static_cast<uint16_t>(operation);
+    request.nameLength = static_cast<uint32_t>(graph.size());
+    request.u = u;
+    request.v = v;
+
+    std::string frame(reinterpret_cast<const char*>(&request), sizeof(request));
+    frame += graph;
+    if (!graphprotocol::writeFull(fd, frame.data(), frame.size())) {
+      return Response<std::string>(ErrorCode::WRITE_FAILED, "Error: Could not send the request");
+    }
+
+    ResponseHeader header;
+    if (!graphprotocol::readFull(fd, &header, sizeof(header))) {
+      return Response<std::string>(ErrorCode::READ_FAILED, "Error: Connection closed by the server");
+    }
+    if (header.magic != graphprotocol::RESPONSE_MAGIC || header.requestId != request.requestId) {
+      return Response<std::string>(ErrorCode::INVALID_FORMAT, "Error: Unexpected response");
+    }
+
+    std::string payload(header.payloadLength, '\0');
+    if (!graphprotocol::readFull(fd, payload.data(), payload.size())) {
+      return Response<std::string>(ErrorCode::READ_FAILED, "Error: Connection closed by the server");
+    }
+
+    Status status = static_cast<Status>(header.status);
+    if (status != Status::OK) return Response<std::string>(ErrorCode::INVALID_ARGUMENT, graphprotocol::statusToString(status));
+    return Response<std::string>(std::move(payload));
+  }
+
+
+  //---- Métodos públicos ----//
+
+  GraphClient::~GraphClient() {
+    if (fd >= 0) ::close(fd);
+  }
+
+  Response<void> GraphClient::connect(const std::string& socketPath) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path)) {
+      return Response<void>(ErrorCode::INVALID_ARGUMENT, "Error: Socket path is empty or too long");
+    }
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    if (fd >= 0) ::close(fd);
+    fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return Response<void>(ErrorCode::OPEN_FAILED, "Error: Could not create socket");
+
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+      ::close(fd);
+      fd = -1;
+      return Response<void>(ErrorCode::OPEN_FAILED, "Error: Could not connect to " + socketPath + ": " + std::strerror(errno));
+    }
+    return Response<void>();
+  }
+
+  Response<void> GraphClient::ping() {
+    Response<std::string> res = call(Operation::PING, "");
+    if (!res.isOk()) return Response<void>(res.code, std::move(res.message));
+    return Response<void>();
+  }
+
+  Response<std::vector<std::string>> GraphClient::list() {
+    Response<std::string> res = call(Operation::LIST, "");
+    if (!res.isOk()) return Response<std::vector<std::string>>(res.code, std::move(res.message));
+
+    std::vector<std::string> names;
+    std::string name;
+    std::istringstream lines(res.value);
+    while (std::getline(lines, name)) {
+      if (!name.empty()) names.push_back(name);
+    }
+    return Response<std::vector<std::string>>(std::move(names));
+  }
+
+  Response<GraphInfo> GraphClient::info(const std::string& graph) {
+    Response<std::string> res = call(Operation::INFO, graph);
+    if (!res.isOk()) return Response<GraphInfo>(res.code, std::move(res.message));
+
+    std::vector<int32_t> values = __values(res.value);
+    if (values.size() != 5) return Response<GraphInfo>(ErrorCode::INVALID_FORMAT, "Error: Malformed info response");
+
+    GraphInfo info;
+    info.vertices = values[0];
+    info.edges = values[1];
+    info.bridges = values[2];
+    info.twoEdgeComponents = values[3];
+    info.connectedComponents = values[4];
+    return Response<GraphInfo>(std::move(info));
+  }
+
+  Response<EdgeVector> GraphClient::bridges(const std::string& graph) {
+    Response<std::string> res = call(Operation::BRIDGES, graph);
+    if (!res.isOk()) return Response<EdgeVector>(res.code, std::move(res.message));
+
+    std::vector<int32_t> values = __values(res.value);
+    EdgeVector edges;
+    edges.reserve(values.size() / 2);
+    for (size_t i = 0; i + 1 < values.size(); i += 2) edges.emplace_back(values[i], values[i + 1]);
+    return Response<EdgeVector>(std::move(edges));
+  }
+
+  Response<bool> GraphClient::connected(const std::string& graph, int u, int v) {
+    Response<std::string> res = call(Operation::CONNECTED, graph, u, v);
+    if (!res.isOk()) return Response<bool>(res.code, std::move(res.message));
+
+    std::vector<int32_t> values = __values(res.value);
+    return Response<bool>(!values.empty() && values[0] != 0);
+  }
+
+  Response<bool> GraphClient::twoEdgeConnected(const std::string& graph, int u, int v) {
+    Response<std::string> res = call(Operation::TWO_EDGE, graph, u, v);
+    if (!res.isOk()) return Response<bool>(res.code, std::move(res.message));
+
+    std::vector<int32_t> values = __values(res.value);
+    return Response<bool>(!values.empty() && values[0] != 0);
+  }
+
+  Response<std::vector<int>> GraphClient::eulerianPath(const std::string& graph) {
+    Response<std::string> res = call(Operation::EULERIAN_PATH, graph);
+    if (!res.isOk()) return Response<std::vector<int>>(res.code, std::move(res.message));
+
+    std::vector<int32_t> values = __values(res.value);
+    return Response<std::vector<int>>(std::vector<int>(values.begin(), values.end()));
+  }
+}
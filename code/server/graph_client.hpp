@@ -0,0 +1,58 @@
+#ifndef GRAPH_CLIENT_HPP
+#define GRAPH_CLIENT_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "graph.hpp"
+#include "protocol.hpp"
+#include "response_struct.hpp"
+
+
+namespace graphserver {
+
+    struct GraphInfo {
+        int vertices = 0;
+        int edges = 0;
+        int bridges = 0;
+        int twoEdgeComponents = 0;
+        int connectedComponents = 0;
+    };
+
+    /**
+     * @brief Blocking client of GraphServer, one request in flight at a time
+     *
+     * Server statuses become INVALID_ARGUMENT responses, with the status as message.
+     */
+    class GraphClient {
+      private:
+        int fd = -1;
+        uint32_t nextId = 1;
+
+        Response<std::string> call(graphprotocol::Operation operation, const std::string& graph, int u = 0, int v = 0);
+
+      public:
+        GraphClient() = default;
+        ~GraphClient();
+
+        GraphClient(const GraphClient&) = delete;
+        GraphClient& operator=(const GraphClient&) = delete;
+
+        Response<void> connect(const std::string& socketPath);
+
+        Response<void> ping();
+        Response<std::vector<std::string>> list();
+        Response<GraphInfo> info(const std::string& graph);
+
+        /// @brief (u, v) pairs with u < v, sorted
+        Response<EdgeVector> bridges(const std::string& graph);
+        Response<bool> connected(const std::string& graph, int u, int v);
+        Response<bool> twoEdgeConnected(const std::string& graph, int u, int v);
+
+        /// @brief Vertex sequence, empty when the graph has none
+        Response<std::vector<int>> eulerianPath(const std::string& graph);
+    };
+}
+
+
+#endif  // GRAPH_CLIENT_HPP
@@ -0,0 +1,396 @@
+#include "graph_server.hpp"
+#include "trace.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+
+namespace graphserver {
+
+  using graphprotocol::Operation;
+  using graphprotocol::RequestHeader;
+  using graphprotocol::ResponseHeader;
+  using graphprotocol::Status;
+
+  /// @brief Client socket, closed when the I/O thread and every pending request let it go
+  struct Connection {
+    int fd;
+    std::mutex outboxMutex;               // Workers append, the I/O thread flushes
+    std::string outbox;                   // Responses the socket did not take yet
+    std::atomic<uint64_t> pending{0};     // Requests queued and not answered yet
+    std::atomic<bool> broken{false};      // A send failed, the client is gone
+
+    // Only touched by the I/O thread
+    std::string inbox;                    // Incomplete frames, and complete ones waiting for room on the queue
+    bool waiting = false;                 // Complete frames wait on the inbox
+    bool readClosed = false;              // The client stopped sending, kept until every answer is out
+
+    explicit Connection(int fd) : fd(fd) {}
+    ~Connection() { ::close(fd); }
+  };
+
+
+  //---- Métodos auxiliares ----//
+
+  int __labelConnected(const CsrGraph& graph, std::vector<int>& labels) {
+    labels.assign(graph.V, -1);
+    std::vector<int> stack;
+    int quantity = 0;
+
+    for (int root = 0; root < graph.V; root++) {
+      if (labels[root] != -1) continue;
+      labels[root] = quantity;
+      stack.push_back(root);
+      while (!stack.empty()) {
+        int v = stack.back();
+        stack.pop_back();
+        for (int w : graph.neighbours(v)) {
+          if (labels[w] == -1) {
+            labels[w] = quantity;
+            stack.push_back(w);
+          }
+        }
+      }
+      quantity++;
+    }
+    return quantity;
+  }
+
+  void __appendValues(std::string& out, const std::vector<int32_t>& values) {
+    out.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(int32_t));
+  }
+
+  bool __needsGraph(Operation operation) {
+    return operation != Operation::PING && operation != Operation::LIST;
+  }
+
+  /**
+   * @brief Moves complete frames of the inbox to the queue while it has room. False on a malformed frame
+   *
+   * Never waits: on a full queue the frames stay on the inbox, `waiting` is set and `starved`
+   * asks the workers for a wake-up once they free a slot.
+   */
+  bool __takeFrames(const std::shared_ptr<Connection>& connection, BoundedQueue<PendingRequest>& queue, std::atomic<bool>& starved) {
+    std::string& inbox = connection->inbox;
+    size_t offset = 0;
+    connection->waiting = false;
+
+    while (inbox.size() - offset >= sizeof(RequestHeader)) {
+      RequestHeader header;
+      std::memcpy(&header, inbox.data() + offset, sizeof(header));
+      if (header.magic != graphprotocol::REQUEST_MAGIC || header.nameLength > graphprotocol::MAX_NAME_LENGTH) return false;
+
+      size_t frameSize = sizeof(header) + header.nameLength;
+      if (inbox.size() - offset < frameSize) break;
+
+      PendingRequest request{connection, header, inbox.substr(offset + sizeof(header), header.nameLength)};
+      connection->pending.fetch_add(1);
+      if (!queue.tryPush(request)) {
+        // Flag first, then retry: a slot freed in between is either seen here or wakes the I/O thread
+        starved.store(true);
+        if (!queue.tryPush(request)) {
+          connection->pending.fetch_sub(1);
+          connection->waiting = true;
+          break;
+        }
+      }
+      offset += frameSize;
+    }
+    inbox.erase(0, offset);
+    return true;
+  }
+
+  /// @brief Sends as much of the outbox as the socket takes, the caller holds outboxMutex. False when the client is gone
+  bool __flush(Connection& connection) {
+    size_t sent = 0;
+    bool alive = true;
+    while (sent < connection.outbox.size()) {
+      ssize_t written = ::send(connection.fd, connection.outbox.data() + sent, connection.outbox.size() - sent, MSG_NOSIGNAL | MSG_DONTWAIT);
+      if (written > 0) {
+        sent += static_cast<size_t>(written);
+      } else if (written < 0 && errno == EINTR) {
+        continue;
+      } else {
+        alive = written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+        break;
+      }
+    }
+    if (alive) connection.outbox.erase(0, sent);
+    else connection.outbox.clear();
+    return alive;
+  }
+
+  size_t __outboxSize(Connection& connection) {
+    std::lock_guard<std::mutex> lock(connection.outboxMutex);
+    return connection.outbox.size();
+  }
+
+
+  //---- Métodos privados ----//
+
+  void GraphServer::answer(const PendingRequest& request, std::string& out) const {
+    ResponseHeader header;
+    header.requestId = request.header.requestId;
+    header.operation = request.header.operation;
+
+    Operation operation = static_cast<Operation>(request.header.operation);
+    const int32_t u = request.header.u, v = request.header.v;
+    std::string payload;
+    std::vector<int32_t> values;
+    Status status = Status::OK;
+
+    const ResidentGraph *graph = nullptr;
+    if (request.header.operation > static_cast<uint16_t>(Operation::EULERIAN_PATH)) {
+      status = Status::INVALID_REQUEST;
+    } else if (__needsGraph(operation)) {
+      auto found = graphs.find(request.name);
+      if (found == graphs.end()) status = Status::UNKNOWN_GRAPH;
+      else graph = found->second.get();
+    }
+
+    if (status == Status::OK && (operation == Operation::CONNECTED || operation == Operation::TWO_EDGE)) {
+      if (u < 0 || v < 0 || u >= graph->results.graph.V || v >= graph->results.graph.V) status = Status::INVALID_VERTEX;
+    }
+
+    if (status == Status::OK) {
+      switch (operation) {
+        case Operation::PING:
+          break;
+        case Operation::LIST:
+          for (const auto& [name, resident] : graphs) payload += name + "\n";
+          break;
+        case Operation::INFO:
+          values = {graph->results.graph.V, graph->results.graph.getTotalQuantityEdges(),
+                    static_cast<int32_t>(graph->results.bridges.size()), graph->results.componentQuantity,
+                    graph->connectedQuantity};
+          break;
+        case Operation::BRIDGES:
+          values.reserve(graph->results.bridges.size() * 2);
+          for (const auto& [a, b] : graph->results.bridges) {
+            values.push_back(a);
+            values.push_back(b);
+          }
+          break;
+        case Operation::CONNECTED:
+          values.push_back(graph->connected[u] == graph->connected[v]);
+          break;
+        case Operation::TWO_EDGE:
+          values.push_back(graph->results.components[u] == graph->results.components[v]);
+          break;
+        case Operation::EULERIAN_PATH:
+          values.assign(graph->results.eulerianPath.begin(), graph->results.eulerianPath.end());
+          break;
+      }
+      __appendValues(payload, values);
+    }
+
+    header.status = static_cast<uint16_t>(status);
+    header.payloadLength = payload.size();
+    out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    out += payload;
+  }
+
+  void GraphServer::wake() {
+    char byte = 1;
+    ssize_t ignored = ::write(wakePipe[1], &byte, 1);  // A full pipe already holds a wake-up
+    (void) ignored;
+  }
+
+  void GraphServer::work() {
+    std::vector<PendingRequest> batch;
+    std::string out;
+
+    while (queue.popBatch(batch, options.batchSize)) {
+      TRACE_SPAN("server.batch");
+      batchCount.fetch_add(1, std::memory_order_relaxed);
+      requestCount.fetch_add(batch.size(), std::memory_order_relaxed);
+      // Frames waiting for room on the queue can be taken now
+      if (queueStarved.exchange(false)) wake();
+      bool wakeUp = false;
+
+      // Requests of the same connection end up together and leave on one send
+      std::stable_sort(batch.begin(), batch.end(), [](const PendingRequest& a, const PendingRequest& b) {
+        return a.connection.get() < b.connection.get();
+      });
+
+      for (size_t i = 0; i < batch.size();) {
+        Connection *connection = batch[i].connection.get();
+        size_t first = i;
+        out.clear();
+        for (; i < batch.size() && batch[i].connection.get() == connection; i++) answer(batch[i], out);
+
+        {
+          std::lock_guard<std::mutex> lock(connection->outboxMutex);
+          if (!connection->broken.load()) {
+            // Responses already waiting go first, so the new ones are only sent when the outbox is empty
+            bool empty = connection->outbox.empty();
+            connection->outbox += out;
+            if (empty && !__flush(*connection)) connection->broken.store(true);
+          }
+          // The I/O thread polls for writability, drops broken connections and idle half-closed ones
+          uint64_t left = connection->pending.fetch_sub(i - first) - (i - first);
+          wakeUp = wakeUp || !connection->outbox.empty() || connection->broken.load() || left == 0;
+        }
+      }
+      batch.clear();
+      if (wakeUp) wake();
+    }
+  }
+
+
+  //---- Métodos públicos ----//
+
+  GraphServer::GraphServer(ServerOptions options) : options(std::move(options)), queue(this->options.queueCapacity) {
+    if (::pipe2(wakePipe, O_NONBLOCK | O_CLOEXEC) != 0) {
+      wakePipe[0] = wakePipe[1] = -1;
+    }
+  }
+
+  GraphServer::~GraphServer() {
+    if (wakePipe[0] != -1) ::close(wakePipe[0]);
+    if (wakePipe[1] != -1) ::close(wakePipe[1]);
+  }
+
+  TimedResponse<void> GraphServer::load(const std::string& name, const std::string& file) {
+    TimedResponse<resultcache::GraphResults> res = resultcache::loadGraphResults(file, options.cache);
+    if (!res.isOk()) return TimedResponse<void>(res.code, file + ": " + res.describe(), res.duration);
+
+    auto resident = std::make_shared<ResidentGraph>();
+    resident->name = name;
+    resident->file = file;
+    resident->results = std::move(res.value);
+    resident->connectedQuantity = __labelConnected(resident->results.graph, resident->connected);
+
+    graphs[name] = std::move(resident);
+    return TimedResponse<void>(res.duration);
+  }
+
+  Response<void> GraphServer::run() {
+    if (wakePipe[0] == -1) return Response<void>(ErrorCode::OPEN_FAILED, "Error: Could not create the wake-up pipe");
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (options.socketPath.empty() || options.socketPath.size() >= sizeof(address.sun_path)) {
+      return Response<void>(ErrorCode::INVALID_ARGUMENT, "Error: Socket path is empty or too long");
+    }
+    std::strncpy(address.sun_path, options.socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    int listener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listener < 0) return Response<void>(ErrorCode::OPEN_FAILED, "Error: Could not create socket");
+
+    ::unlink(options.socketPath.c_str());
+    if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(listener, 128) != 0) {
+      ::close(listener);
+      return Response<void>(ErrorCode::OPEN_FAILED, "Error: Could not bind " + options.socketPath + ": " + std::strerror(errno));
+    }
+
+    unsigned workerQuantity = options.workers > 0 ? options.workers : std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < workerQuantity; i++) {
+      workers.emplace_back([this, i]() {
+        tracing::setThreadName("worker " + std::to_string(i));
+        work();
+      });
+    }
+
+    // pollfd 0 is the wake-up pipe, 1 the listener, the rest follow `connections`
+    std::vector<std::shared_ptr<Connection>> connections;
+    std::vector<pollfd> polled;
+    char buffer[64 * 1024];
+    bool running = true;
+
+    while (running) {
+      // Frames left on the inbox when the queue was full go first
+      for (const std::shared_ptr<Connection>& connection : connections) {
+        if (connection->waiting && !__takeFrames(connection, queue, queueStarved)) connection->broken.store(true);
+      }
+
+      polled.assign({{wakePipe[0], POLLIN, 0}, {listener, POLLIN, 0}});
+      for (const std::shared_ptr<Connection>& connection : connections) {
+        size_t unsent = __outboxSize(*connection);
+        short events = 0;
+        if (!connection->waiting && !connection->readClosed && unsent < options.outboxLimit) events |= POLLIN;
+        if (unsent > 0) events |= POLLOUT;
+        // Nothing to wait for (queue or workers will wake the loop): a negative fd is skipped by poll
+        polled.push_back({events != 0 ? connection->fd : -1, events, 0});
+      }
+
+      if (::poll(polled.data(), polled.size(), -1) < 0) {
+        if (errno == EINTR) continue;
+        break;
+      }
+      if (polled[0].revents != 0) {
+        while (::read(wakePipe[0], buffer, sizeof(buffer)) > 0) {}
+        if (stopping.load()) running = false;
+      }
+
+      if (polled[1].revents & POLLIN) {
+        int client = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK);
+        if (client >= 0) {
+          connections.push_back(std::make_shared<Connection>(client));
+          connectionCount.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+
+      // Connections accepted on this round were not polled yet
+      std::vector<std::shared_ptr<Connection>> kept;
+      for (size_t i = 0; i < connections.size(); i++) {
+        Connection& connection = *connections[i];
+        short events = i + 2 < polled.size() ? polled[i + 2].revents : 0;
+        bool open = !connection.broken.load() && !(events & (POLLERR | POLLNVAL));
+
+        if (open && (events & (POLLIN | POLLHUP)) && !connection.readClosed) {
+          ssize_t received = ::read(connection.fd, buffer, sizeof(buffer));
+          if (received > 0) {
+            connection.inbox.append(buffer, static_cast<size_t>(received));
+            open = __takeFrames(connections[i], queue, queueStarved);
+          } else if (received == 0) {
+            connection.readClosed = true;
+          } else if (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK) {
+            open = false;
+          }
+        }
+
+        if (open && (events & POLLOUT)) {
+          std::lock_guard<std::mutex> lock(connection.outboxMutex);
+          open = __flush(connection);
+        }
+
+        // A half-closed client still gets the answers of the requests it sent
+        bool done = connection.readClosed && !connection.waiting && connection.pending.load() == 0 && __outboxSize(connection) == 0;
+
+        // Requests still queued keep their connection alive until answered
+        if (open && !done) kept.push_back(std::move(connections[i]));
+        else connections[i]->broken.store(true);
+      }
+      connections.swap(kept);
+    }
+
+    queue.close();
+    for (std::thread& worker : workers) worker.join();
+    connections.clear();
+    ::close(listener);
+    ::unlink(options.socketPath.c_str());
+    return Response<void>();
+  }
+
+  void GraphServer::stop() {
+    stopping.store(true);
+    if (wakePipe[1] != -1) wake();
+  }
+
+  ServerStats GraphServer::stats() const {
+    ServerStats current;
+    current.connections = connectionCount.load(std::memory_order_relaxed);
+    current.requests = requestCount.load(std::memory_order_relaxed);
+    current.batches = batchCount.load(std::memory_order_relaxed);
+    return current;
+  }
+}
@@ -0,0 +1,109 @@
+#ifndef GRAPH_SERVER_HPP
+#define GRAPH_SERVER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "protocol.hpp"
+#include "result_cache.hpp"
+#include "bounded_queue.hpp"
+#include "response_struct.hpp"
+
+
+/**
+ * @brief Daemon that keeps graphs resident and answers queries over a Unix domain socket
+ *
+ * Graphs are loaded once through the result cache, so bridges, 2-edge-connected
+ * components and the Eulerian path are computed (or read from the sidecar) at startup
+ * and every query is a lookup on memory: latency excludes I/O and parsing.
+ *
+ * One I/O thread polls the listening socket and the connections and turns complete
+ * frames into requests. Workers take the queued requests in batches, answer them and
+ * append the responses of each connection of the batch to its outbox, sending right away
+ * what the socket takes. The I/O thread flushes the rest once the socket is writable.
+ *
+ * Sockets never block either side: a client that stops reading its responses only stalls
+ * itself. Past `outboxLimit` unsent bytes its connection is no longer read, and when the
+ * queue is full the frames wait on the inbox of their connection instead of the I/O thread.
+ */
+namespace graphserver {
+
+    struct ServerOptions {
+        std::string socketPath;
+        unsigned workers = 0;         // 0 uses std::thread::hardware_concurrency()
+        size_t batchSize = 64;        // Most requests a worker takes at once
+        size_t queueCapacity = 4096;  // Pending requests before connections stop being read
+        size_t outboxLimit = size_t(1) << 20;  // Unsent response bytes before a connection stops being read
+        resultcache::CacheOptions cache;
+    };
+
+    /// @brief Graph and everything answered about it, immutable once loaded
+    struct ResidentGraph {
+        std::string name;
+        std::string file;
+        resultcache::GraphResults results;
+        std::vector<int> connected;  // Connected component of each vertex
+        int connectedQuantity = 0;
+    };
+
+    struct ServerStats {
+        uint64_t connections = 0;
+        uint64_t requests = 0;
+        uint64_t batches = 0;
+    };
+
+    struct Connection;
+
+    struct PendingRequest {
+        std::shared_ptr<Connection> connection;
+        graphprotocol::RequestHeader header;
+        std::string name;
+    };
+
+
+    class GraphServer {
+      private:
+        ServerOptions options;
+        std::map<std::string, std::shared_ptr<const ResidentGraph>> graphs;  // Read-only while serving
+        BoundedQueue<PendingRequest> queue;
+        int wakePipe[2] = {-1, -1};      // Wakes the I/O thread: stop(), outboxes to flush, room on the queue
+        std::atomic<bool> stopping{false};
+        std::atomic<bool> queueStarved{false};  // Some frames wait for room on the queue
+
+        std::atomic<uint64_t> connectionCount{0};
+        std::atomic<uint64_t> requestCount{0};
+        std::atomic<uint64_t> batchCount{0};
+
+        void wake();
+        void work();
+        void answer(const PendingRequest& request, std::string& out) const;
+
+      public:
+        explicit GraphServer(ServerOptions options);
+        ~GraphServer();
+
+        GraphServer(const GraphServer&) = delete;
+        GraphServer& operator=(const GraphServer&) = delete;
+
+        /// @brief Loads a .graph file under `name`, before run()
+        TimedResponse<void> load(const std::string& name, const std::string& file);
+
+        /**
+         * @brief Binds the socket and serves until stop()
+         *
+         * A stale socket file on the path is replaced, it is removed on return.
+         */
+        Response<void> run();
+
+        /// @brief Makes run() return. Async-signal-safe, may be called from a signal handler
+        void stop();
+
+        ServerStats stats() const;
+    };
+}
+
+
+#endif  // GRAPH_SERVER_HPP
@@ -0,0 +1,112 @@
+#ifndef GRAPH_PROTOCOL_HPP
+#define GRAPH_PROTOCOL_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <unistd.h>
+
+
+/**
+ * @brief Binary protocol of the graph server, over a Unix domain socket
+ *
+ * Both sides are on the same machine, so every field is in host byte order.
+ *
+ * Request:  RequestHeader, then `nameLength` bytes with the graph name
+ * Response: ResponseHeader, then `payloadLength` bytes
+ *
+ * Payloads are arrays of int32:
+ * - BRIDGES:        (u, v) pairs, u < v, sorted
+ * - CONNECTED:      one value, 1 when u and v are on the same connected component
+ * - TWO_EDGE:       one value, 1 when u and v are 2-edge-connected (no bridge separates them)
+ * - EULERIAN_PATH:  vertex sequence, empty when the graph has none
+ * - INFO:           V, E, bridges, 2-edge-connected components, connected components
+ * - LIST:           names of the loaded graphs, '\n' separated (bytes, not int32)
+ *
+ * Responses of a connection may come out of order, `requestId` pairs them with requests.
+ */
+namespace graphprotocol {
+
+    const uint32_t REQUEST_MAGIC = 0x31514247;   // "GBQ1"
+    const uint32_t RESPONSE_MAGIC = 0x31524247;  // "GBR1"
+    const uint32_t MAX_NAME_LENGTH = 4096;
+
+    enum class Operation : uint16_t {
+        PING = 0,
+        LIST,
+        INFO,
+        BRIDGES,
+        CONNECTED,
+        TWO_EDGE,
+        EULERIAN_PATH
+    };
+
+    enum class Status : uint16_t {
+        OK = 0,
+        UNKNOWN_GRAPH,
+        INVALID_VERTEX,
+        INVALID_REQUEST
+    };
+
+    struct RequestHeader {
+        uint32_t magic = REQUEST_MAGIC;
+        uint32_t requestId = 0;
+        uint16_t operation = 0;
+        uint16_t reserved = 0;
+        uint32_t nameLength = 0;
+        int32_t u = 0;
+        int32_t v = 0;
+    };
+
+    struct ResponseHeader {
+        uint32_t magic = RESPONSE_MAGIC;
+        uint32_t requestId = 0;
+        uint16_t operation = 0;
+        uint16_t status = 0;
+        uint32_t reserved = 0;
+        uint64_t payloadLength = 0;
+    };
+
+    static_assert(sizeof(RequestHeader) == 24, "RequestHeader must have no padding");
+    static_assert(sizeof(ResponseHeader) == 24, "ResponseHeader must have no padding");
+
+    inline const char* statusToString(Status status) {
+        switch (status) {
+            case Status::OK: return "ok";
+            case Status::UNKNOWN_GRAPH: return "unknown graph";
+            case Status::INVALID_VERTEX: return "vertex out of range";
+            case Status::INVALID_REQUEST: return "invalid request";
+        }
+        return "unknown status";
+    }
+
+
+    /// @brief Writes every byte, retrying on partial writes and signals
+    inline bool writeFull(int fd, const void *data, size_t size) {
+        const char *bytes = static_cast<const char*>(data);
+        while (size > 0) {
+            ssize_t written = ::write(fd, bytes, size);
+            if (written < 0 && errno == EINTR) continue;
+            if (written <= 0) return false;
+            bytes += written;
+            size -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+
+    /// @brief Reads exactly `size` bytes, false on error or end of stream
+    inline bool readFull(int fd, void *data, size_t size) {
+        char *bytes = static_cast<char*>(data);
+        while (size > 0) {
+            ssize_t received = ::read(fd, bytes, size);
+            if (received < 0 && errno == EINTR) continue;
+            if (received <= 0) return false;
+            bytes += received;
+            size -= static_cast<size_t>(received);
+        }
+        return true;
+    }
+}
+
+
+#endif  // GRAPH_PROTOCOL_HPP
@@ -0,0 +1,289 @@
+#include "graph_server.hpp"
+#include "graph_client.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+    graphserver::GraphServer *activeServer = nullptr;
+
+    void printUsage(std::ostream& out) {
+        out << "Usage:" << std::endl
+            << "  GraphServer serve --socket PATH --graph [NAME=]FILE... [options]" << std::endl
+            << "  GraphServer query --socket PATH OPERATION [GRAPH [U V]]" << std::endl
+            << "  GraphServer bench --socket PATH --graph NAME [--clients N] [--requests N]" << std::endl
+            << std::endl
+            << "Serve:" << std::endl
+            << "  --graph [NAME=]FILE   Repeatable. A folder loads every .graph file, named after the file" << std::endl
+            << "  --workers N           Worker threads (default: hardware threads)" << std::endl
+            << "  --batch N             Most requests a worker answers at once (default 64)" << std::endl
+            << "  --queue N             Pending requests before reads stop (default 4096)" << std::endl
+            << "  --no-cache            Do not write .cache sidecars of the loaded graphs" << std::endl
+            << std::endl
+            << "Query operations: ping, list, info G, bridges G, connected G U V, two-edge G U V, euler G" << std::endl
+            << std::endl
+            << "Bench: random two-edge queries from N clients, prints latency percentiles" << std::endl;
+    }
+
+    void handleSignal(int) {
+        if (activeServer != nullptr) activeServer->stop();
+    }
+
+    bool parseNumber(const std::string& text, long long& value) {
+        char *end = nullptr;
+        value = std::strtoll(text.c_str(), &end, 10);
+        return !text.empty() && end != nullptr && *end == '\0';
+    }
+
+    /// @brief "NAME=FILE", a file (named after its stem) or a folder of .graph files
+    std::vector<std::pair<std::string, std::string>> expandGraphs(const std::string& spec) {
+        size_t equals = spec.find('=');
+        if (equals != std::string::npos) return {{spec.substr(0, equals), spec.substr(equals + 1)}};
+
+        std::vector<std::pair<std::string, std::string>> graphs;
+        if (std::filesystem::is_directory(spec)) {
+            for (const auto& entry : std::filesystem::directory_iterator(spec)) {
+                if (entry.path().extension() == ".graph") graphs.push_back({entry.path().stem().string(), entry.path().string()});
+            }
+            std::sort(graphs.begin(), graphs.end());
+        } else {
+            graphs.push_back({std::filesystem::path(spec).stem().string(), spec});
+        }
+        return graphs;
+    }
+
+    int serve(const graphserver::ServerOptions& options, const std::vector<std::string>& specs) {
+        graphserver::GraphServer server(options);
+        for (const std::string& spec : specs) {
+            for (const auto& [name, file] : expandGraphs(spec)) {
+                TimedResponse<void> res = server.load(name, file);
+                if (!res.isOk()) {
+                    std::cerr << res.describe() << std::endl;
+                    return 1;
+                }
+                std::cerr << "Loaded " << name << " (" << file << ") in " << res.duration << "ms" << std::endl;
+            }
+        }
+
+        activeServer = &server;
+        std::signal(SIGINT, handleSignal);
+        std::signal(SIGTERM, handleSignal);
+        std::signal(SIGPIPE, SIG_IGN);  // Clients that leave early fail the write, not the process
+
+        std::cerr << "Serving on " << options.socketPath << std::endl;
+        Response<void> res = server.run();
+        activeServer = nullptr;
+        if (!res.isOk()) {
+            std::cerr << res.describe() << std::endl;
+            return 1;
+        }
+
+        graphserver::ServerStats stats = server.stats();
+        std::cerr << "Served " << stats.requests << " requests in " << stats.batches << " batches from "
+                  << stats.connections << " connections" << std::endl;
+        return 0;
+    }
+
+    int query(const std::string& socketPath, const std::vector<std::string>& args) {
+        if (args.empty()) {
+            printUsage(std::cerr);
+            return 1;
+        }
+
+        graphserver::GraphClient client;
+        Response<void> connected = client.connect(socketPath);
+        if (!connected.isOk()) {
+            std::cerr << connected.describe() << std::endl;
+            return 1;
+        }
+
+        const std::string& operation = args[0];
+        std::string graph = args.size() > 1 ? args[1] : "";
+        long long u = 0, v = 0;
+        if ((operation == "connected" || operation == "two-edge")
+            && (args.size() != 4 || !parseNumber(args[2], u) || !parseNumber(args[3], v))) {
+            std::cerr << operation << " needs a graph and two vertices" << std::endl;
+            return 1;
+        }
+
+        auto fail = [](const char *message) {
+            std::cerr << message << std::endl;
+            return 1;
+        };
+
+        if (operation == "ping") {
+            Response<void> res = client.ping();
+            if (!res.isOk()) return fail(res.describe());
+            std::cout << "pong" << std::endl;
+        } else if (operation == "list") {
+            Response<std::vector<std::string>> res = client.list();
+            if (!res.isOk()) return fail(res.describe());
+            for (const std::string& name : res.value) std::cout << name << std::endl;
+        } else if (operation == "info") {
+            Response<graphserver::GraphInfo> res = client.info(graph);
+            if (!res.isOk()) return fail(res.describe());
+            std::cout << "vertices " << res.value.vertices << std::endl
+                      << "edges " << res.value.edges << std::endl
+                      << "bridges " << res.value.bridges << std::endl
+                      << "2-edge-connected components " << res.value.twoEdgeComponents << std::endl
+                      << "connected components " << res.value.connectedComponents << std::endl;
+        } else if (operation == "bridges") {
+            Response<EdgeVector> res = client.bridges(graph);
+            if (!res.isOk()) return fail(res.describe());
+            for (const auto& [a, b] : res.value) std::cout << a << " " << b << std::endl;
+        } else if (operation == "connected" || operation == "two-edge") {
+            Response<bool> res = operation == "connected" ? client.connected(graph, static_cast<int>(u), static_cast<int>(v))
+                                                          : client.twoEdgeConnected(graph, static_cast<int>(u), static_cast<int>(v));
+            if (!res.isOk()) return fail(res.describe());
+            std::cout << (res.value ? "yes" : "no") << std::endl;
+        } else if (operation == "euler") {
+            Response<std::vector<int>> res = client.eulerianPath(graph);
+            if (!res.isOk()) return fail(res.describe());
+            for (size_t i = 0; i < res.value.size(); i++) std::cout << (i > 0 ? " " : "") << res.value[i];
+            std::cout << std::endl;
+        } else {
+            std::cerr << "Unknown operation: " << operation << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    int bench(const std::string& socketPath, const std::string& graph, int clients, int requests) {
+        graphserver::GraphClient probe;
+        Response<void> connected = probe.connect(socketPath);
+        Response<graphserver::GraphInfo> info = connected.isOk() ? probe.info(graph) : Response<graphserver::GraphInfo>(connected.code, connected.message);
+        if (!info.isOk() || info.value.vertices == 0) {
+            std::cerr << (info.isOk() ? "Graph has no vertices" : info.describe()) << std::endl;
+            return 1;
+        }
+
+        std::vector<std::vector<double>> latencies(clients);
+        std::vector<int> failures(clients, 0);
+        std::vector<std::thread> threads;
+        auto begin = std::chrono::steady_clock::now();
+
+        for (int c = 0; c < clients; c++) {
+            threads.emplace_back([&, c]() {
+                graphserver::GraphClient client;
+                if (!client.connect(socketPath).isOk()) {
+                    failures[c] = requests;
+                    return;
+                }
+                std::mt19937 rng(c + 1);
+                std::uniform_int_distribution<int> vertex(0, info.value.vertices - 1);
+                for (int i = 0; i < requests; i++) {
+                    auto start = std::chrono::steady_clock::now();
+                    Response<bool> res = client.twoEdgeConnected(graph, vertex(rng), vertex(rng));
+                    auto end = std::chrono::steady_clock::now();
+                    if (!res.isOk()) failures[c]++;
+                    latencies[c].push_back(std::chrono::duration<double, std::micro>(end - start).count());
+                }
+            });
+        }
+        for (std::thread& thread : threads) thread.join();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+        std::vector<double> all;
+        int failed = 0;
+        for (int c = 0; c < clients; c++) {
+            all.insert(all.end(), latencies[c].begin(), latencies[c].end());
+            failed += failures[c];
+        }
+        if (all.empty()) {
+            std::cerr << "No request was answered" << std::endl;
+            return 1;
+        }
+        std::sort(all.begin(), all.end());
+        auto at = [&](double p) { return all[std::min(all.size() - 1, static_cast<size_t>(p * all.size()))]; };
+
+        std::cout << all.size() << " requests from " << clients << " clients in " << seconds << "s ("
+                  << all.size() / seconds << " req/s), " << failed << " failed" << std::endl
+                  << "latency [micro]: p50 " << at(0.50) << ", p95 " << at(0.95) << ", p99 " << at(0.99)
+                  << ", max " << all.back() << std::endl;
+        return failed > 0 ? 1 : 0;
+    }
+}
+
+
+int main(int argc, char **argv) {
+    if (argc < 2 || std::string(argv[1]) == "--help" || std::string(argv[1]) == "-h") {
+        printUsage(argc < 2 ? std::cerr : std::cout);
+        return argc < 2 ? 1 : 0;
+    }
+
+    const std::string mode = argv[1];
+    graphserver::ServerOptions options;
+    std::vector<std::string> graphs, positional;
+    long long clients = 4, requests = 10000;
+
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << std::endl;
+                std::exit(1);
+            }
+            return argv[++i];
+        };
+        auto number = [&]() -> long long {
+            long long value;
+            std::string text = next();
+            if (!parseNumber(text, value) || value < 0) {
+                std::cerr << "Invalid value for " << arg << ": " << text << std::endl;
+                std::exit(1);
+            }
+            return value;
+        };
+
+        if (arg == "--socket") options.socketPath = next();
+        else if (arg == "--graph") graphs.push_back(next());
+        else if (arg == "--workers") options.workers = static_cast<unsigned>(number());
+        else if (arg == "--batch") options.batchSize = static_cast<size_t>(number());
+        else if (arg == "--queue") options.queueCapacity = static_cast<size_t>(number());
+        else if (arg == "--no-cache") options.cache.writeCache = false;
+        else if (arg == "--clients") clients = std::max(1LL, number());
+        else if (arg == "--requests") requests = std::max(1LL, number());
+        else if (arg.rfind("--", 0) == 0) {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            printUsage(std::cerr);
+            return 1;
+        } else {
+            positional.push_back(arg);
+        }
+    }
+
+    if (options.socketPath.empty()) {
+        std::cerr << "--socket is required" << std::endl;
+        return 1;
+    }
+
+    if (mode == "serve") {
+        if (graphs.empty()) {
+            std::cerr << "serve needs at least one --graph" << std::endl;
+            return 1;
+        }
+        return serve(options, graphs);
+    }
+    if (mode == "query") return query(options.socketPath, positional);
+    if (mode == "bench") {
+        if (graphs.size() != 1) {
+            std::cerr << "bench needs one --graph name" << std::endl;
+            return 1;
+        }
+        return bench(options.socketPath, graphs[0], static_cast<int>(clients), static_cast<int>(requests));
+    }
+
+    std::cerr << "Unknown mode: " << mode << std::endl;
+    printUsage(std::cerr);
+    return 1;
+}
@@ -0,0 +1,120 @@
+#include "streaming.hpp"
+#include "graph.hpp"
+#include "csr_graph.hpp"
+#include "trace.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+
+
+namespace streaming {
+
+    //---- DisjointSets ----//
+
+    DisjointSets::DisjointSets(int n) : parent(n), rank(n, 0) {
+        std::iota(parent.begin(), parent.end(), 0);
+    }
+
+    int DisjointSets::find(int v) {
+        while (parent[v] != v) {
+            parent[v] = parent[parent[v]];
+            v = parent[v];
+        }
+        return v;
+    }
+
+    bool DisjointSets::unite(int u, int v) {
+        u = find(u);
+        v = find(v);
+        if (u == v) return false;
+
+        if (rank[u] < rank[v]) std::swap(u, v);
+        parent[v] = u;
+        if (rank[u] == rank[v]) rank[u]++;
+        return true;
+    }
+
+
+    //---- BridgeCertificate ----//
+
+    BridgeCertificate::BridgeCertificate(int n) : n(n), first(n), second(n) {
+        retained.reserve(n > 0 ? 2 * static_cast<size_t>(n) - 2 : 0);
+    }
+
+    EdgeVector BridgeCertificate::bridges() const {
+        // Parallel copies are kept: a doubled edge is not a bridge
+        CsrGraph certificate = csr::buildSymmetric(n, retained);
+        return tarjanAllComponents(certificate);
+    }
+
+
+    //---- Métodos públicos ----//
+
+    Response<EdgeVector> findBridgesFromFile(const std::string& filename, std::vector<char>& ioBuffer, StreamingStats *stats) {
+        TRACE_SPAN("streaming");
+        std::ifstream in;
+        ioBuffer.resize(ioBuffer.capacity());
+        if (!ioBuffer.empty()) in.rdbuf()->pubsetbuf(ioBuffer.data(), ioBuffer.size());
+        in.open(filename, std::ios::binary);
+        if (!in) return Response<EdgeVector>(ErrorCode::OPEN_FAILED, "Error: Could not open input file for reading");
+
+        int n = 0;
+        in.read(reinterpret_cast<char*>(&n), sizeof(n));
+        if (!in || n < 0) return Response<EdgeVector>(ErrorCode::INVALID_FORMAT, "Error: Invalid vertex quantity on input file");
+
+        BridgeCertificate certificate(n);
+        uint64_t bytesRead = sizeof(n);
+
+        // Lists of any length go through this fixed chunk
+        const int CHUNK = 4096;
+        int chunk[CHUNK];
+        for (int u = 0; u < n; u++) {
+            int length;
+            in.read(reinterpret_cast<char*>(&length), sizeof(length));
+            if (!in || length < 0) return Response<EdgeVector>(ErrorCode::READ_FAILED, "Error: Corrupted adjacency list on input file");
+            bytesRead += sizeof(length);
+
+            while (length > 0) {
+                int count = std::min(length, CHUNK);
+                in.read(reinterpret_cast<char*>(chunk), sizeof(int) * count);
+                if (!in) return Response<EdgeVector>(ErrorCode::READ_FAILED, "Error: Corrupted adjacency list on input file");
+                bytesRead += sizeof(int) * count;
+                length -= count;
+
+                for (int i = 0; i < count; i++) {
+                    int v = chunk[i];
+                    if (v < 0 || v >= n) return Response<EdgeVector>(ErrorCode::INVALID_FORMAT, "Error: Neighbour out of range on input file");
+                    if (u < v) certificate.add(u, v);  // The copy on the list of v is skipped
+                }
+            }
+        }
+
+        if (stats != nullptr) {
+            stats->vertices = n;
+            stats->edges = certificate.getOfferedEdges();
+            stats->retained = certificate.getRetainedEdges();
+            stats->bytesRead = bytesRead;
+        }
+        return Response<EdgeVector>(certificate.bridges());
+    }
+
+    template <typename G>
+    EdgeVector findBridges(const G& graph) {
+        TRACE_SPAN("streaming");
+        BridgeCertificate certificate(graph.getVertexQuantity());
+        for (int u = 0; u < graph.getVertexQuantity(); u++) {
+            for (int v : graph.neighbours(u)) {
+                if (u < v) certificate.add(u, v);
+            }
+        }
+        return certificate.bridges();
+    }
+
+
+#define INSTANTIATE_STREAMING(G) \
+    template EdgeVector findBridges<G>(const G& graph);
+
+    INSTANTIATE_STREAMING(Graph)
+    INSTANTIATE_STREAMING(CsrGraph)
+}
@@ -0,0 +1,103 @@
+#ifndef STREAMING_HPP
+#define STREAMING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "tarjan.hpp"
+#include "response_struct.hpp"
+
+
+/**
+ * @brief Semi-streaming bridges: one pass over the edges, O(V) memory
+ *
+ * Every edge of the stream is offered to two union-find forests:
+ * - it joins the first forest when it links two of its trees
+ * - otherwise it joins the second forest when it links two of its trees
+ * - otherwise it is dropped
+ *
+ * The first forest is a maximal spanning forest of the graph, the second one a maximal
+ * spanning forest of what is left, and their union (at most 2V-2 edges) is a certificate
+ * of 2-edge-connectivity: a cut crossed by two or more edges of the graph is crossed by two
+ * or more retained edges. So the bridges of the certificate are exactly the bridges of the
+ * graph, and Tarjan only runs on the certificate.
+ *
+ * Memory is two parent arrays and the retained edges, whatever the quantity of edges.
+ */
+namespace streaming {
+
+    /// @brief Union-find with path halving and union by rank
+    class DisjointSets {
+      private:
+        std::vector<int> parent;
+        std::vector<uint8_t> rank;
+
+      public:
+        explicit DisjointSets(int n);
+
+        int find(int v);
+
+        /// @brief False when u and v were already on the same set
+        bool unite(int u, int v);
+    };
+
+
+    class BridgeCertificate {
+      private:
+        int n;
+        DisjointSets first, second;
+        EdgeVector retained;
+        uint64_t offered = 0;
+        size_t forestEdges = 0;  // Retained edges of the first forest, they come first in `retained`
+
+      public:
+        explicit BridgeCertificate(int n);
+
+        /// @brief Offers one copy of an undirected edge. Self-loops are ignored, they are never bridges
+        void add(int u, int v) {
+            if (u == v) return;
+            offered++;
+            if (first.unite(u, v)) {
+                retained.emplace_back(u, v);
+                forestEdges++;
+            } else if (second.unite(u, v)) {
+                retained.emplace_back(u, v);
+            }
+        }
+
+        int getVertexQuantity() const { return n; }
+        uint64_t getOfferedEdges() const { return offered; }
+        size_t getRetainedEdges() const { return retained.size(); }
+        size_t getForestEdges() const { return forestEdges; }
+
+        /// @brief Bridges of every component of the edges offered so far, as (min, max) pairs in sorted order
+        EdgeVector bridges() const;
+    };
+
+
+    struct StreamingStats {
+        int vertices = 0;
+        uint64_t edges = 0;         // Edges read, one per parallel copy, self-loops excluded
+        size_t retained = 0;        // Certificate size, at most 2V-2
+        uint64_t bytesRead = 0;
+    };
+
+    /**
+     * @brief Bridges of a .graph file, read sequentially once without building the graph
+     *
+     * Each edge is taken from the list of its lowest endpoint. The lists are read in fixed
+     * chunks through `ioBuffer` (the whole capacity is used as stream buffer), so resident
+     * memory only depends on the vertex quantity.
+     *
+     * Same result as tarjanAllComponents() over the loaded graph.
+     */
+    Response<EdgeVector> findBridgesFromFile(const std::string& filename, std::vector<char>& ioBuffer, StreamingStats *stats = nullptr);
+
+    /// @brief Feeds every edge of an in-memory graph through a certificate, for comparisons with Tarjan
+    template <typename G>
+    EdgeVector findBridges(const G& graph);
+}
+
+
+#endif  // STREAMING_HPP
@@ -1,6 +1,7 @@
 #include "tarjan.hpp"
 #include "graph_reader.hpp"
 #include "graph.hpp"
+#include "trace.hpp"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -14,28 +15,42 @@
 #include <fstream>
 #include <string>
 #include <stack>
+#include <algorithm>
 
 
 
 
-TarjanData::TarjanData(const Graph& graph) {
-    int n = graph.getVertexQuantity();
-    data = new int[n * 2];
-    memset(data, -1, n * 2 * sizeof(int));
+template <typename G>
+TarjanData<G>::TarjanData(const G& graph) {
+    size_t n = graph.getVertexQuantity();
+    data = new Vertex[n * 2];
+    memset(data, -1, n * 2 * sizeof(Vertex)); // All bits set is -1 for any signed id type
 
     tin = data;
     low = tin + n;
 
     this->graph = &graph;
-    bridges = EdgeVector();
+    bridges = BasicEdgeVector<Vertex>();
 }
 
-TarjanData::~TarjanData() {
+template <typename G>
+TarjanData<G>::~TarjanData() {
     delete[] data;
 }
 
-EdgeVector tarjan(const Graph &graph) {
-    TarjanData args(graph);
+template <typename G>
+BasicEdgeVector<typename G::Vertex> tarjan(const G &graph) {
+    algostats::NoStats stats;
+    return tarjan(graph, stats);
+}
+
+template <typename G, typename Stats>
+BasicEdgeVector<typename G::Vertex> tarjan(const G &graph, Stats& stats) {
+    static_assert(!G::TraitsType::directed, "Bridges are only defined for undirected graphs");
+    TRACE_SPAN("tarjan");
+    stats.traversal();
+
+    TarjanData<G> args(graph);
     //iteration in all vertex to make sure every vertex will be visited, even if the graph isn't connected
     /*for (int i = 0; i < graph.getVertexQuantity(); ++i) {
         if (!wasVisited(i, &args)) {
@@ -43,11 +58,59 @@ EdgeVector tarjan(const Graph &graph) {
         }
     }*/
     // _dfs(&args, 0, -1);
-    _dfs(&args, 0);
+    _dfs(&args, 0, stats);
     return args.bridges;
 }
 
-bool wasVisited(int vertex, TarjanData* args){
+template <typename G>
+BasicEdgeVector<typename G::Vertex> tarjanAllComponents(const G &graph) {
+    using Vertex = typename G::Vertex;
+    TRACE_SPAN("tarjan");
+    TarjanData<G> args(graph);
+    algostats::NoStats stats;
+    for (Vertex v = 0; v < graph.getVertexQuantity(); v++) {
+        if (!wasVisited(v, &args)) _dfs(&args, v, stats);
+    }
+
+    BasicEdgeVector<Vertex> bridges = std::move(args.bridges);
+    for (auto& [u, v] : bridges) {
+        if (u > v) std::swap(u, v);
+    }
+    std::sort(bridges.begin(), bridges.end());
+    return bridges;
+}
+
+template <typename G>
+typename G::Vertex labelTwoEdgeComponents(const G &graph, const BasicEdgeVector<typename G::Vertex> &bridges, typename G::Vertex *labels) {
+    using Vertex = typename G::Vertex;
+    const Vertex n = graph.getVertexQuantity();
+    std::fill(labels, labels + n, Vertex(-1));
+    std::vector<Vertex> queue;
+    Vertex quantity = 0;
+
+    for (Vertex root = 0; root < n; root++) {
+        if (labels[root] != -1) continue;
+
+        labels[root] = quantity;
+        queue.clear();
+        queue.push_back(root);
+        for (size_t head = 0; head < queue.size(); head++) {
+            Vertex v = queue[head];
+            for (Vertex w : graph.neighbours(v)) {
+                if (labels[w] != -1) continue;
+                if (std::binary_search(bridges.begin(), bridges.end(), std::make_pair(std::min(v, w), std::max(v, w)))) continue;
+
+                labels[w] = quantity;
+                queue.push_back(w);
+            }
+        }
+        quantity++;
+    }
+    return quantity;
+}
+
+template <typename G>
+bool wasVisited(typename G::Vertex vertex, TarjanData<G>* args){
     return args->tin[vertex] != -1;
 }
 
@@ -59,7 +122,7 @@ bool wasVisited(int vertex, TarjanData* args){
 //     args.visited[v] = true;
 //     args.tin[v] = args.low[v] = args.time++; 
 
-//     for (int u : args.graph->adj[v]) {
+//     for (int u : args.graph->neighbours(v)) {
 //         if (u == parent) continue;
 
 //         if (args.visited[u]) {
@@ -83,33 +146,50 @@ bool wasVisited(int vertex, TarjanData* args){
 //     *argsPtr = std::move(args); 
 // }
 
-void _dfs(TarjanData *argsPtr, int start) {
-    TarjanData &args = *argsPtr;
-    std::stack<std::pair<int, int>> stack;
+template <typename G, typename Stats>
+void _dfs(TarjanData<G> *argsPtr, typename G::Vertex start, Stats& stats) {
+    using Vertex = typename G::Vertex;
+    TarjanData<G> &args = *argsPtr;
+    std::stack<std::pair<Vertex, Vertex>> stack;
     
     // stack.push({start, -1});
     //first iteration to remove a comparison from the while
     args.tin[start] = args.low[start] = args.time++;
-    for (int u : args.graph->adj[start]) {
+    stats.visitVertex();
+    for (Vertex u : args.graph->neighbours(start)) {
+        stats.scanEdge();
         if (!wasVisited(u, &args)) {
             stack.push({u, start});
         }
     }
+    stats.stackSize(stack.size());
 
     while (!stack.empty()) {
         auto [v, parent] = stack.top();
         
         if (!wasVisited(v, &args)) {
             args.tin[v] = args.low[v] = args.time++;
-            for (int u : args.graph->adj[v]) {
-                if (u == parent){ 
+            stats.visitVertex();
+            bool skippedParent = false;
+            for (Vertex u : args.graph->neighbours(v)) {
+                stats.scanEdge();
+                if constexpr (G::TraitsType::multigraph) {
+                    // A parallel edge to the parent is a back edge
+                    if (u == parent && !skippedParent) {
+                        skippedParent = true;
+                        continue;
+                    }
+                } else if (u == parent) {
                     continue;
-                } else if (wasVisited(u, &args)) {
+                }
+
+                if (wasVisited(u, &args)) {
                     args.low[v] = std::min(args.low[v], args.tin[u]);
                 } else {
                     stack.push({u, v});
                 }
             }
+            stats.stackSize(stack.size());
         } else {
             stack.pop();
             args.low[parent] = std::min(args.low[v], args.low[parent]);
@@ -121,5 +201,21 @@ void _dfs(TarjanData *argsPtr, int start) {
 }
 
 
-
-
+#define INSTANTIATE_TARJAN(G) \
+    template struct TarjanData<G>; \
+    template void _dfs<G, algostats::NoStats>(TarjanData<G> *argsPtr, typename G::Vertex start, algostats::NoStats& stats); \
+    template void _dfs<G, algostats::CountingStats>(TarjanData<G> *argsPtr, typename G::Vertex start, algostats::CountingStats& stats); \
+    template bool wasVisited<G>(typename G::Vertex vertex, TarjanData<G>* args); \
+    template BasicEdgeVector<typename G::Vertex> tarjan<G>(const G &graph); \
+    template BasicEdgeVector<typename G::Vertex> tarjan<G, algostats::NoStats>(const G &graph, algostats::NoStats& stats); \
+    template BasicEdgeVector<typename G::Vertex> tarjan<G, algostats::CountingStats>(const G &graph, algostats::CountingStats& stats); \
+    template BasicEdgeVector<typename G::Vertex> tarjanAllComponents<G>(const G &graph); \
+    template typename G::Vertex labelTwoEdgeComponents<G>(const G &graph, const BasicEdgeVector<typename G::Vertex> &bridges, typename G::Vertex *labels);
+
+INSTANTIATE_TARJAN(Graph)
+INSTANTIATE_TARJAN(BasicGraph<SmallGraphTraits>)
+INSTANTIATE_TARJAN(BasicGraph<WideGraphTraits>)
+INSTANTIATE_TARJAN(BasicGraph<SimpleGraphTraits>)
+INSTANTIATE_TARJAN(CompressedGraph)
+INSTANTIATE_TARJAN(CsrGraph)
+INSTANTIATE_TARJAN(CsrView)
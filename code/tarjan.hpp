@@ -5,9 +5,12 @@
 #include <vector>
 #include <string>
 #include "graph.hpp"
+#include "compressed_graph.hpp"
+#include "csr_graph.hpp"
+#include "algorithm_stats.hpp"
 
 typedef std::vector<std::vector<int>> AdjGraph;
-typedef std::vector<std::pair<int,int>> EdgeVector;
+typedef BasicEdgeVector<int> EdgeVector;
 
 
 
@@ -36,18 +39,25 @@ typedef std::vector<std::pair<int,int>> EdgeVector;
  * - low-link values (lowest indirect link found) [2n...3n-1]
  * 
  * Pointers for each subarray is stored for easier use, each allowed to only access indexes [0...n-1]
+ * 
+ * The graph type only needs getVertexQuantity(), neighbours(v), Vertex and TraitsType, so the
+ * same search runs over every BasicGraph, CsrGraph, CsrView and CompressedGraph. Arrays use the vertex
+ * id type of the graph. Supported types are instantiated on tarjan.cpp
  */
+template <typename G>
 struct TarjanData {
+    using Vertex = typename G::Vertex;
+
     private: 
-        int *data;
+        Vertex *data;
     
     public: 
-        const Graph *graph;
-        EdgeVector bridges;
+        const G *graph;
+        BasicEdgeVector<Vertex> bridges;
 
-        int time = 0;
+        Vertex time = 0;
         // int *visited, *tin, *low;
-        int *tin, *low;
+        Vertex *tin, *low;
 
         /**
          * @brief Constructs a TarjanData object for the provided graph.
@@ -58,7 +68,7 @@ struct TarjanData {
          * @param graph The graph on which Tarjan's algorithm will be applied.
          */
         
-        TarjanData(const Graph &graph);
+        TarjanData(const G &graph);
         ~TarjanData();
 };
 
@@ -80,7 +90,8 @@ struct TarjanData {
 // void _dfs(TarjanData *argsPtr, int v, int parent);
 
 
-void _dfs(TarjanData *argsPtr, int start);
+template <typename G, typename Stats>
+void _dfs(TarjanData<G> *argsPtr, typename G::Vertex start, Stats& stats);
 
 /**
  * @brief Performs execution of tarjan algorithm and return list of bridges
@@ -90,12 +101,40 @@ void _dfs(TarjanData *argsPtr, int start);
  * @param graph Graph that the algorithm will execute on
  * @return EdgeVector containing all found bridges
  * 
+ * On multigraph traits only the first half-edge back to the parent is skipped, so parallel
+ * edges are never reported as bridges. CompressedGraph lists are decoded while scanned.
+ * 
  * @warning The graph must have vertexes identified as integer numbers on range [0 ... n-1]
  */
-EdgeVector tarjan(const Graph &graph);
+template <typename G>
+BasicEdgeVector<typename G::Vertex> tarjan(const G &graph);
+
+/// @brief tarjan() reporting the search to a statistics policy (see algorithm_stats.hpp)
+template <typename G, typename Stats>
+BasicEdgeVector<typename G::Vertex> tarjan(const G &graph, Stats& stats);
+
+/**
+ * @brief Bridges of every connected component, as (min, max) pairs in sorted order
+ *
+ * tarjan() only searches the component of vertex 0, this one restarts the search on
+ * every vertex left unvisited
+ */
+template <typename G>
+BasicEdgeVector<typename G::Vertex> tarjanAllComponents(const G &graph);
+
+/**
+ * @brief Labels the 2-edge-connected components: connected components once the bridges are removed
+ *
+ * @param bridges Sorted (min, max) pairs, as returned by tarjanAllComponents()
+ * @param labels Output, one label per vertex on range [0 ... quantity-1], in order of the lowest vertex
+ * @return Quantity of components
+ */
+template <typename G>
+typename G::Vertex labelTwoEdgeComponents(const G &graph, const BasicEdgeVector<typename G::Vertex> &bridges, typename G::Vertex *labels);
 
 
-bool wasVisited(int vertex, TarjanData* graph);
+template <typename G>
+bool wasVisited(typename G::Vertex vertex, TarjanData<G>* graph);
 
 
 #endif
\ No newline at end of file
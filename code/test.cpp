@@ -5,6 +5,14 @@
 #include "naive.hpp"
 #include "eulerian.hpp"
 #include "randomizer.hpp"
+#include "graph_families.hpp"
+#include "bounded_queue.hpp"
+#include "result_cache.hpp"
+#include "batch.hpp"
+#include "streaming.hpp"
+#include "external.hpp"
+#include "scheduler.hpp"
+#include "trace.hpp"
 #include "test.hpp"
 #include "main.hpp"
 
@@ -14,6 +22,8 @@
 #include <chrono>
 #include <string>
 #include <filesystem>
+#include <algorithm>
+#include <thread>
 
 
 namespace test {
@@ -172,72 +182,119 @@ namespace test {
     }
 
 
-    Response<Graph> _writeResult(const std::string& filename, std::vector<char> ioBuffer, std::ostream& out) {
-        std::chrono::steady_clock::time_point begin, end; 
-
-        begin = std::chrono::steady_clock::now();
-        Response<Graph> result = graphformat::readGraphFromFile(filename, ioBuffer);
-        end = std::chrono::steady_clock::now();
-
-        if (!result.isOk()) {
-            std::cerr << result.message << std::endl;
-            return Response<Graph>("COULD NOT READ", {});
-        }
-
-        Graph graph = std::move(result.value);
-
-        out << "# " << filename << std::endl;
-        out << "read time: " << getDurationInMicro(begin,end) << "[micro]" << std::endl;
-        ioBuffer.clear();
-
-        _bridgeTimes(graph, out);
-        _eulerianTimes(graph, out);
-        
-        
-
-        return graph;
-    }
-    
+    // Graph read by the loader thread, with the duration of the read stage
+    struct _LoadedGraph {
+        size_t folder = 0;
+        std::string filename;
+        Response<Graph> graph = Response<Graph>(ErrorCode::READ_FAILED);
+        long readTime = 0;
+    };
+
+
+    /**
+     * @brief Benchmarks every graph of the folders while the next ones are being read
+     *
+     * A loader thread reads the files in order into a BoundedQueue of `prefetch` graphs,
+     * so at most prefetch + 2 graphs are in memory: the full queue, the one being benchmarked
+     * and the one the loader is reading. Each graph reports its read time
+     * (loader stage), the time the benchmark waited for it (0 when I/O is fully hidden)
+     * and the usual bridge and Eulerian timings.
+     */
+    int _writeResultsPipelined(const std::vector<std::string>& folders, std::vector<std::ofstream>& outs, size_t prefetch) {
+        BoundedQueue<_LoadedGraph> queue(prefetch);
+
+        std::thread loader([&]() {
+            tracing::setThreadName("loader");
+            const size_t bufferSize = 64 * 1024;  // 64KB
+            std::vector<char> ioBuffer(bufferSize);
+
+            for (size_t folder = 0; folder < folders.size(); folder++) {
+                for (int i = 0; i < 10; i++) {
+                    _LoadedGraph loaded;
+                    loaded.folder = folder;
+                    loaded.filename = folders[folder] + std::to_string(i) + ".graph";
+
+                    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+                    loaded.graph = graphformat::readGraphFromFile(loaded.filename, ioBuffer);
+                    loaded.readTime = getDurationInMicro(begin, std::chrono::steady_clock::now());
+
+                    bool failed = !loaded.graph.isOk();
+                    if (!queue.push(std::move(loaded)) || failed) {
+                        queue.close();
+                        return;
+                    }
+                }
+            }
+            queue.close();
+        });
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        long totalRead = 0, totalWait = 0;
+        int status = 0;
+
+        while (true) {
+            std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+            _LoadedGraph loaded;
+            {
+                TRACE_SPAN("wait");
+                if (!queue.pop(loaded)) break;
+            }
+            long wait = getDurationInMicro(begin, std::chrono::steady_clock::now());
 
-    int _writeResults(const std::string& folder, std::vector<char> ioBuffer, std::ostream& out) {
-        for (int i = 0; i < 10; i++) {
-            std::string filename = folder + std::to_string(i) + ".graph";
-            Response<Graph> res =_writeResult(filename, ioBuffer, out);
-            if (!res.isOk()) return -1;
+            if (!loaded.graph.isOk()) {
+                std::cerr << loaded.filename << ": " << loaded.graph.describe() << std::endl;
+                status = -1;
+                break;
+            }
 
+            std::ostream& out = outs[loaded.folder];
+            out << "# " << loaded.filename << std::endl;
+            out << "read time: " << loaded.readTime << "[micro]" << std::endl;
+            out << "wait time: " << wait << "[micro]" << std::endl;
+            totalRead += loaded.readTime;
+            totalWait += wait;
+
+            {
+                TRACE_SPAN("benchmark");
+                _bridgeTimes(loaded.graph.value, out);
+                _eulerianTimes(loaded.graph.value, out);
+            }
 
             out << std::endl << std::endl;
             std::cout << "DONE";
         }
+
+        // Unblocks the loader when the benchmark stopped early
+        queue.close();
+        loader.join();
+
         std::cout << std::endl;
-        std::cout << folder << std::endl;
-        return 0;
+        std::cout << "total: " << getDurationInMicro(start, std::chrono::steady_clock::now()) << "[micro] "
+                  << "read: " << totalRead << "[micro] waited: " << totalWait << "[micro]" << std::endl;
+        return status;
     }
 
 
-
     int execute(const std::vector<int>& nums) {
-        const size_t bufferSize = 64 * 1024;  // 64KB
-        std::vector<char> ioBuffer(bufferSize);
         std::string graphInputContext = "examples/0.3f/";
         const std::string logOutputContext = "examples/bridgesResult/";
+        const size_t prefetch = 2;
         
-        
+        std::vector<std::string> folders;
+        std::vector<std::ofstream> outs;
 
         for (auto num : nums) {
-            const std::string inFolderPath = graphInputContext + std::to_string(num) + "/";
+            folders.push_back(graphInputContext + std::to_string(num) + "/");
             const std::string logPath = logOutputContext + std::to_string(num);
 
-            std::ofstream out(logPath, std::ios::binary | std::ios::trunc);
-            if (!out) {
+            outs.emplace_back(logPath, std::ios::binary | std::ios::trunc);
+            if (!outs.back()) {
                 std::cerr << "Error: Could not open output file for writing" << std::endl;
                 return -1;
             }
-
-            if (_writeResults(inFolderPath, ioBuffer, out) != 0) return -1;
         }
 
-        return 0;
+        return _writeResultsPipelined(folders, outs, prefetch);
     }
 
     int execute() {
@@ -245,41 +302,164 @@ namespace test {
     }
 
 
+    // # TRACED EXECUTION, open the file on chrome://tracing or ui.perfetto.dev
+    int executeTraced(const std::vector<int>& nums, const std::string& traceFile) {
+        tracing::setThreadName("benchmark");
+        tracing::start();
+        int status = execute(nums);
+        tracing::stop();
 
+        Response<void> res = tracing::writeChromeTrace(traceFile);
+        if (!res.isOk()) {
+            std::cerr << res.describe() << std::endl;
+            return -1;
+        }
+        std::cout << "trace: " << traceFile << std::endl;
+        return status;
+    }
 
 
+    // # CACHED RESULTS, recomputed only when a .graph file changes
+    int executeCached(const std::vector<int>& nums) {
+        const std::string graphInputContext = "examples/0.3f/";
 
-    // # GENERATE AND STORE GRAPHS
-    int storeGraph(Graph& graph, std::string filename, std::vector<char> ioBuffer) {
-        std::chrono::steady_clock::time_point begin, end;     
+        for (auto num : nums) {
+            for (int i = 0; i < 10; i++) {
+                std::string filename = graphInputContext + std::to_string(num) + "/" + std::to_string(i) + ".graph";
+
+                std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+                TimedResponse<resultcache::GraphResults> res = resultcache::loadGraphResults(filename);
+                std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+                if (!res.isOk()) {
+                    std::cerr << filename << ": " << res.describe() << std::endl;
+                    return -1;
+                }
+
+                const resultcache::GraphResults& results = res.value;
+                std::cout << filename << (results.fromCache ? " [cached] " : " [computed] ")
+                          << getDurationInMicro(begin, end) << "[micro] bridges: " << results.bridges.size()
+                          << " components: " << results.componentQuantity
+                          << " path: " << results.eulerianPath.size() << std::endl;
+            }
+        }
+        return 0;
+    }
+
+
+
+
+
+
+    // # BATCH, every graph of a folder, glob or manifest on a work-stealing pool
+    int executeBatch(const std::string& spec, const std::string& resultFile, unsigned threads) {
+        Response<std::vector<std::string>> files = batch::collectFiles(spec);
+        if (!files.isOk()) {
+            std::cerr << files.describe() << std::endl;
+            return -1;
+        }
+
+        if (threads > 0) sched::setThreadCount(threads);
+        batch::BatchSummary summary = batch::runBatch(files.value);
+
+        Response<void> res = batch::writeResults(summary, resultFile);
+        if (!res.isOk()) {
+            std::cerr << res.describe() << std::endl;
+            return -1;
+        }
+        std::cout << summary.results.size() << " graphs in " << summary.wallMillis << "[ms], failed: " << summary.failed
+                  << " steals: " << summary.steals << " results: " << resultFile << std::endl;
+        return summary.failed == 0 ? 0 : -1;
+    }
+
+
+
+
+
+
+    // # STREAMING, bridges of a .graph file with O(V) memory
+    int executeStreaming(const std::string& filename) {
+        std::vector<char> ioBuffer(1 << 20);
+        streaming::StreamingStats stats;
+
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        Response<EdgeVector> bridges = streaming::findBridgesFromFile(filename, ioBuffer, &stats);
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        if (!bridges.isOk()) {
+            std::cerr << bridges.describe() << std::endl;
+            return -1;
+        }
+
+        std::cout << "Vertices: " << stats.vertices << " edges: " << stats.edges << " retained: " << stats.retained
+                  << " bytes read: " << stats.bytesRead << std::endl;
+        std::cout << "Bridges: " << bridges.value.size() << " in "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count() << " [microsseconds]" << std::endl;
+        return 0;
+    }
 
-        begin = std::chrono::steady_clock::now();
-        Response<void> writeResult = graphformat::writeGraphToFile(filename, ioBuffer, graph);
-        end = std::chrono::steady_clock::now();
+
+
+
+
+
+    // # EXTERNAL, Tarjan with the adjacency left on disk behind a block cache
+    int executeExternal(const std::string& filename, size_t cacheMegabytes) {
+        external::ExternalOptions options;
+        options.cacheBytes = cacheMegabytes << 20;
+        external::ExternalStats stats;
+
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        Response<EdgeVector> bridges = external::findBridgesExternal(filename, options, &stats);
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        if (!bridges.isOk()) {
+            std::cerr << bridges.describe() << std::endl;
+            return -1;
+        }
+
+        std::cout << "Vertices: " << stats.vertices << " edges: " << stats.edges << " file: " << stats.fileBytes
+                  << " bytes, read: " << stats.bytesRead << " bytes (" << stats.passes << " passes)";
+        if (stats.certificate) {
+            std::cout << " by one certificate pass, the file is larger than the cache" << std::endl;
+        } else {
+            std::cout << " in " << stats.reads << " reads, cache hits: " << stats.hits << " misses: " << stats.misses << std::endl;
+        }
+        std::cout << "Bridges: " << bridges.value.size() << " in "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count() << " [microsseconds]" << std::endl;
+        return 0;
+    }
+
+
+
+
+
+
+    // # GENERATE AND STORE GRAPHS
+    int storeGraph(Graph& graph, const std::string& filename) {
+        TimedResponse<void> writeResult = graphformat::timedWriteGraphBatched(filename, graph);
         if (!writeResult.isOk()) {
-            std::cerr << writeResult.message << std::endl;
+            std::cerr << writeResult.describe() << std::endl;
             return -1;
         } 
-        std::cout << "write time: " << getDurationInMicro(begin,end) << "[micro]" << std::endl;
-        ioBuffer.clear();
+        std::cout << "write time: " << writeResult.duration << "[ms] "
+                  << writeResult.bytesPerSecond / (1024 * 1024) << "[MB/s]" << std::endl;
         return 0;
     }
 
 
-    int generateGraphs(const std::string& fileContext, int quantidadeVertices, float edgePercentage, std::vector<char>& ioBuffer) {
+    int generateGraphs(const std::string& fileContext, int quantidadeVertices, float edgePercentage) {
         std::filesystem::create_directory(fileContext);
 
         for(int i = 0; i < 10; i++) {
             cout << "I: " << i << endl;
             Response<Graph> graph = generateEulerianGraph(quantidadeVertices, edgePercentage);
             if (!graph.isOk()) {
-                std::cerr << graph.message << std::endl;
+                std::cerr << graph.describe() << std::endl;
                 return -1;
             }
             std::cout << "graph generated" << std::endl;
             std::string filename = fileContext + std::to_string(i) + ".graph";
             std::cout << filename << std::endl;
-            storeGraph(graph.value, filename, ioBuffer);
+            storeGraph(graph.value, filename);
             cout << "Quantity of Edges: " << endl << graph.value.getTotalQuantityEdges() << endl;
         }
 
@@ -288,15 +468,12 @@ namespace test {
 
 
     int executeGen(const std::vector<int>& nums) {
-        const size_t bufferSize = 64 * 1024;  // 64KB
-        std::vector<char> ioBuffer(bufferSize);
-
         const float edgePercentage = 0.003f;
         const std::string prefix = "examples/0.3f/";
 
         for (auto num : nums) {
             const std::string filepath = prefix + std::to_string(num) + "/";
-            int res = generateGraphs(filepath, num, edgePercentage, ioBuffer) != 0;
+            int res = generateGraphs(filepath, num, edgePercentage) != 0;
             if (res != 0) return res;
         }
 
@@ -310,5 +487,115 @@ namespace test {
     int executeGen2() {
         return executeGen({100, 250, 500, 750, 1000, 1250, 1500, 1750, 2000, 2250, 2500, 2750, 3000});
     }
-    
+
+
+
+    // # STRUCTURED FAMILIES, CHECKED AGAINST THEIR KNOWN BRIDGES
+    int _familyResult(Response<graphfamily::FamilyGraph> res, std::ostream& out) {
+        if (!res.isOk()) {
+            std::cerr << res.describe() << std::endl;
+            return -1;
+        }
+        graphfamily::FamilyGraph& family = res.value;
+
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        EdgeVector bridges = tarjan(family.graph);
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+        for (auto& [u, v] : bridges) {
+            if (u > v) std::swap(u, v);
+        }
+        std::sort(bridges.begin(), bridges.end());
+        bool correct = bridges == family.bridges;
+
+        out << "# " << family.name << std::endl;
+        out << "V: " << family.graph.getVertexQuantity() << " E: " << family.graph.getTotalQuantityEdges()
+            << " bridges: " << family.bridges.size() << " odd vertices: " << family.oddVertices << std::endl;
+        out << "tarjan: " << getDurationInMicro(begin, end) << "[micro] " << (correct ? "OK" : "MISMATCH") << std::endl;
+
+        return correct ? 0 : -1;
+    }
+
+    int executeFamilies(std::ostream& out) {
+        const uint64_t seed = 12345;
+        int failures = 0;
+
+        failures += _familyResult(graphfamily::rmat(14, 8, seed), out) != 0;
+        failures += _familyResult(graphfamily::grid(300, 300), out) != 0;
+        failures += _familyResult(graphfamily::cactus(5000, 5, 0.3f, seed), out) != 0;
+        failures += _familyResult(graphfamily::blockChain(500, 100, 2.0f, seed), out) != 0;
+        failures += _familyResult(graphfamily::barbell(200, 1000), out) != 0;
+        failures += _familyResult(graphfamily::star(100000), out) != 0;
+        failures += _familyResult(graphfamily::deepPath(50000), out) != 0;
+
+        return failures == 0 ? 0 : -1;
+    }
+
+    int executeFamilies() {
+        return executeFamilies(std::cout);
+    }
+
+
+
+    // # CANONICAL MODE, SAME GRAPH BUILT ON TWO INSERTION ORDERS
+    template <typename Traits>
+    int _canonicalResult(const std::string& name, int n, const EdgeVector& edges, std::ostream& out) {
+        BasicGraph<Traits> forward(n), backward(n);
+        for (const auto& [u, v] : edges) forward.addEdge(u, v);
+        for (size_t k = edges.size(); k-- > 0;) backward.addEdge(edges[k].second, edges[k].first);
+        uint64_t before = forward.fingerprint();
+
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        forward.canonicalize();
+        backward.canonicalize();
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+        // Multigraphs keep every copy, so the fingerprint must not move
+        bool correct = forward.isCanonical() && backward.isCanonical() && forward.isEqual(backward)
+                       && forward.fingerprint() == backward.fingerprint()
+                       && (!Traits::multigraph || forward.fingerprint() == before);
+        for (const auto& [u, v] : edges) {
+            correct = correct && forward.hasEdge(u, v) && forward.hasEdge(v, u) && backward.hasEdge(u, v);
+        }
+
+        // Insertions keep the mode: a new edge lands on both lists, still sorted
+        forward.addEdge(0, n - 1);
+        backward.addEdge(n - 1, 0);
+        correct = correct && forward.isCanonical() && forward.isEqual(backward) && forward.hasEdge(n - 1, 0);
+
+        out << "# " << name << std::endl;
+        out << "V: " << n << " E: " << forward.getTotalQuantityEdges() << std::endl;
+        out << "canonicalize: " << getDurationInMicro(begin, end) << "[micro] " << (correct ? "OK" : "MISMATCH") << std::endl;
+        return correct ? 0 : -1;
+    }
+
+    int executeCanonical(std::ostream& out) {
+        const int n = 20000;
+        randomgraph::GeneratorOptions options;
+        options.seed = 12345;
+        Response<Graph> generated = randomgraph::createConectedGraph(n, 0.001f, options);
+        if (!generated.isOk()) {
+            std::cerr << generated.describe() << std::endl;
+            return -1;
+        }
+
+        EdgeVector edges;
+        for (int u = 0; u < n; u++) {
+            for (int v : generated.value.adj[u]) {
+                if (u < v) edges.emplace_back(u, v);
+            }
+        }
+        // A parallel copy and a self-loop, kept on multigraphs and collapsed on simple graphs
+        edges.push_back(edges.front());
+        edges.emplace_back(1, 1);
+
+        int failures = 0;
+        failures += _canonicalResult<DefaultGraphTraits>("canonical multigraph", n, edges, out) != 0;
+        failures += _canonicalResult<SimpleGraphTraits>("canonical simple graph", n, edges, out) != 0;
+        return failures == 0 ? 0 : -1;
+    }
+
+    int executeCanonical() {
+        return executeCanonical(std::cout);
+    }
 }
\ No newline at end of file
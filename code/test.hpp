@@ -17,9 +17,18 @@ namespace test {
     // Function prototypes
     int execute(const std::vector<int>& nums);
     int execute();
-    int generateGraphs(const std::string& fileContext, int quantidadeVertices, float edgePercentage, std::vector<char>& ioBuffer);
+    int generateGraphs(const std::string& fileContext, int quantidadeVertices, float edgePercentage);
     int executeGen(const std::vector<int>& nums);
     int executeGen();
+    int executeFamilies(std::ostream& out);
+    int executeFamilies();
+    int executeCanonical(std::ostream& out);
+    int executeCanonical();
+    int executeCached(const std::vector<int>& nums);
+    int executeTraced(const std::vector<int>& nums, const std::string& traceFile);
+    int executeBatch(const std::string& spec, const std::string& resultFile, unsigned threads = 0);
+    int executeStreaming(const std::string& filename);
+    int executeExternal(const std::string& filename, size_t cacheMegabytes = 64);
 
 }
 
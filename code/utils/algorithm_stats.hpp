@@ -0,0 +1,51 @@
+#ifndef ALGORITHM_STATS_HPP
+#define ALGORITHM_STATS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+
+/**
+ * @brief Statistics policies of the bridge and Eulerian engines
+ *
+ * Engines take the policy as a template parameter and report through it what they do:
+ * adjacency entries scanned, vertices visited, the size of their explicit stacks, the
+ * traversals they start and the calls made to a bridge oracle (isBridge on the naive
+ * search, tarjan()/executeNaive() on each Fleury step).
+ *
+ * NoStats is the default: its members are empty inline functions, so the calls vanish
+ * from optimized builds. CountingStats is used by GraphBench --stats.
+ */
+namespace algostats {
+
+    struct NoStats {
+        static constexpr bool enabled = false;
+
+        void scanEdge() {}
+        void visitVertex() {}
+        void stackSize(size_t) {}
+        void traversal() {}
+        void oracleCall() {}
+    };
+
+    struct CountingStats {
+        static constexpr bool enabled = true;
+
+        uint64_t edgesScanned = 0;     // Adjacency entries read
+        uint64_t verticesVisited = 0;
+        uint64_t stackHighWater = 0;   // Largest explicit stack of a traversal
+        uint64_t traversals = 0;       // Full searches started (DFS of tarjan, connectivity checks)
+        uint64_t oracleCalls = 0;      // Questions asked to a bridge oracle
+
+        void scanEdge() { edgesScanned++; }
+        void visitVertex() { verticesVisited++; }
+        void stackSize(size_t size) {
+            if (size > stackHighWater) stackHighWater = size;
+        }
+        void traversal() { traversals++; }
+        void oracleCall() { oracleCalls++; }
+    };
+}
+
+
+#endif  // ALGORITHM_STATS_HPP
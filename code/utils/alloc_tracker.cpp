@@ -0,0 +1,107 @@
+#include "alloc_tracker.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+
+
+namespace alloctracker {
+
+  // Constant initialized, so allocations done before main() are safe
+  std::atomic<bool> __hooked{false};
+  std::atomic<bool> __enabled{false};
+  std::atomic<uint64_t> __allocations{0};
+  std::atomic<uint64_t> __frees{0};
+  std::atomic<uint64_t> __allocatedBytes{0};
+  std::atomic<uint64_t> __liveBytes{0};
+  std::atomic<uint64_t> __peakBytes{0};
+
+  bool hooked() {
+    return __hooked.load(std::memory_order_relaxed);
+  }
+
+  void setEnabled(bool enabled) {
+    __enabled.store(enabled, std::memory_order_relaxed);
+  }
+
+  bool enabled() {
+    return __enabled.load(std::memory_order_relaxed);
+  }
+
+  AllocStats snapshot() {
+    AllocStats stats;
+    stats.allocations = __allocations.load(std::memory_order_relaxed);
+    stats.frees = __frees.load(std::memory_order_relaxed);
+    stats.allocatedBytes = __allocatedBytes.load(std::memory_order_relaxed);
+    stats.liveBytes = __liveBytes.load(std::memory_order_relaxed);
+    stats.peakBytes = __peakBytes.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+  void resetPeak() {
+    __peakBytes.store(__liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+
+
+  //---- Memória residente ----//
+
+  // Reads a "Name:   1234 kB" line of /proc/self/status
+  uint64_t __statusKilobytes(const char *field) {
+    std::FILE *status = std::fopen("/proc/self/status", "r");
+    if (status == nullptr) return 0;
+
+    char line[256];
+    size_t length = std::strlen(field);
+    unsigned long long kilobytes = 0;
+    while (std::fgets(line, sizeof(line), status) != nullptr) {
+      if (std::strncmp(line, field, length) == 0 && line[length] == ':') {
+        std::sscanf(line + length + 1, "%llu", &kilobytes);
+        break;
+      }
+    }
+    std::fclose(status);
+    return static_cast<uint64_t>(kilobytes) * 1024;
+  }
+
+  uint64_t currentRssBytes() {
+    return __statusKilobytes("VmRSS");
+  }
+
+  uint64_t peakRssBytes() {
+    return __statusKilobytes("VmHWM");
+  }
+
+  bool resetPeakRss() {
+    std::FILE *refs = std::fopen("/proc/self/clear_refs", "w");
+    if (refs == nullptr) return false;
+    bool ok = std::fputs("5", refs) >= 0;
+    return std::fclose(refs) == 0 && ok;
+  }
+
+
+  //---- Hooks ----//
+
+  void markHooked() {
+    __hooked.store(true, std::memory_order_relaxed);
+  }
+
+  void recordAllocation(size_t bytes) {
+    if (!__enabled.load(std::memory_order_relaxed)) return;
+
+    __allocations.fetch_add(1, std::memory_order_relaxed);
+    __allocatedBytes.fetch_add(bytes, std::memory_order_relaxed);
+    uint64_t live = __liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+    uint64_t peak = __peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !__peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+  }
+
+  void recordFree(size_t bytes) {
+    if (!__enabled.load(std::memory_order_relaxed)) return;
+
+    __frees.fetch_add(1, std::memory_order_relaxed);
+    // Blocks allocated before tracking was enabled would underflow the live count
+    uint64_t live = __liveBytes.load(std::memory_order_relaxed);
+    while (!__liveBytes.compare_exchange_weak(live, live >= bytes ? live - bytes : 0, std::memory_order_relaxed)) {}
+  }
+}
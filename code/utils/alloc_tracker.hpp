@@ -0,0 +1,58 @@
+#ifndef ALLOC_TRACKER_HPP
+#define ALLOC_TRACKER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+
+/**
+ * @brief Process-wide heap accounting, fed by the operator new/delete hooks
+ *
+ * The hooks are not part of the core library: an executable opts in by linking
+ * bench/alloc_hooks.cpp (GraphBench does). Without them every counter stays zero and
+ * hooked() is false. Even when linked, nothing is counted until setEnabled(true), the
+ * only cost being a relaxed load per allocation.
+ *
+ * Counters are atomics shared by every thread, so allocations of worker threads
+ * (e.g. the parallel generators) are included.
+ */
+namespace alloctracker {
+
+    struct AllocStats {
+        uint64_t allocations = 0;
+        uint64_t frees = 0;
+        uint64_t allocatedBytes = 0;  // Requested bytes, not counting allocator overhead
+        uint64_t liveBytes = 0;
+        uint64_t peakBytes = 0;       // Highest liveBytes since the last resetPeak()
+    };
+
+    /// @brief True when the operator new/delete hooks are linked in
+    bool hooked();
+
+    void setEnabled(bool enabled);
+    bool enabled();
+
+    AllocStats snapshot();
+
+    /// @brief Starts a new high-water mark from the current live bytes
+    void resetPeak();
+
+    /// @brief Resident set size (VmRSS) in bytes, 0 when unknown
+    uint64_t currentRssBytes();
+
+    /// @brief Highest resident set size (VmHWM) in bytes, 0 when unknown
+    uint64_t peakRssBytes();
+
+    /// @brief Restarts VmHWM from the current RSS (Linux clear_refs), false when not supported
+    bool resetPeakRss();
+
+
+    //---- Usados pelos hooks ----//
+
+    void markHooked();
+    void recordAllocation(size_t bytes);
+    void recordFree(size_t bytes);
+}
+
+
+#endif  // ALLOC_TRACKER_HPP
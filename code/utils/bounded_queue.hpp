@@ -0,0 +1,108 @@
+#ifndef BOUNDED_QUEUE_HPP
+#define BOUNDED_QUEUE_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+
+/**
+ * @brief Blocking FIFO with a fixed capacity, for producer/consumer pipelines
+ *
+ * push() waits while the queue is full, so a fast producer (e.g. a loader thread) stays
+ * at most `capacity` items ahead of the consumer and memory stays bounded. Items are
+ * moved in and out, so move-only types such as Response<Graph> are accepted.
+ *
+ * close() wakes everyone: further pushes are rejected and pop() returns false once
+ * the remaining items are drained.
+ */
+template <typename T>
+class BoundedQueue {
+  private:
+    std::deque<T> items;
+    size_t capacity;
+    bool closed = false;
+
+    std::mutex mutex;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+
+  public:
+    explicit BoundedQueue(size_t capacity) : capacity(capacity == 0 ? 1 : capacity) {}
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    /// @brief Waits for a free slot. Returns false if the queue was closed
+    bool push(T&& item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [&]() { return closed || items.size() < capacity; });
+        if (closed) return false;
+
+        items.push_back(std::move(item));
+        lock.unlock();
+        notEmpty.notify_one();
+        return true;
+    }
+
+    /// @brief Never waits: false when the queue is full or closed, `item` is only moved on success
+    bool tryPush(T& item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (closed || items.size() >= capacity) return false;
+
+        items.push_back(std::move(item));
+        lock.unlock();
+        notEmpty.notify_one();
+        return true;
+    }
+
+    /// @brief Waits for an item. Returns false when the queue is closed and empty
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [&]() { return closed || !items.empty(); });
+        if (items.empty()) return false;
+
+        item = std::move(items.front());
+        items.pop_front();
+        lock.unlock();
+        notFull.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Waits for an item, then takes it with every other queued one, up to `maxItems`
+     *
+     * Appends to `batch`. Returns false when the queue is closed and empty
+     */
+    bool popBatch(std::vector<T>& batch, size_t maxItems) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [&]() { return closed || !items.empty(); });
+        if (items.empty()) return false;
+
+        size_t taken = 0;
+        while (!items.empty() && taken < std::max<size_t>(maxItems, 1)) {
+            batch.push_back(std::move(items.front()));
+            items.pop_front();
+            taken++;
+        }
+        lock.unlock();
+        notFull.notify_all();
+        return true;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+        }
+        notFull.notify_all();
+        notEmpty.notify_all();
+    }
+};
+
+
+#endif  // BOUNDED_QUEUE_HPP
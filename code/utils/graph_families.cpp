@@ -0,0 +1,323 @@
+#include "graph_families.hpp"
+#include "graph.hpp"
+#include "csr_graph.hpp"
+#include "response_struct.hpp"
+#include "rng.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+namespace graphfamily {
+
+  //---- Métodos auxiliares ----//
+
+  /**
+   * @brief Bridges of a simple graph, iterative low-link over every component
+   *
+   * Kept apart from tarjan.cpp on purpose, it is the reference the engines are checked against.
+   */
+  EdgeVector __findBridges(const CsrGraph& graph) {
+    int n = graph.V;
+    EdgeVector bridges;
+    std::vector<int> disc(n, -1), low(n, 0), parent(n, -1);
+    std::vector<uint64_t> next(graph.offsets.begin(), graph.offsets.end() - 1);
+    std::vector<int> stack;
+    int time = 0;
+
+    for (int root = 0; root < n; root++) {
+      if (disc[root] != -1) continue;
+
+      disc[root] = low[root] = time++;
+      stack.push_back(root);
+
+      while (!stack.empty()) {
+        int v = stack.back();
+
+        if (next[v] < graph.offsets[v + 1]) {
+          int w = graph.neighbourList[next[v]++];
+          if (disc[w] == -1) {
+            parent[w] = v;
+            disc[w] = low[w] = time++;
+            stack.push_back(w);
+          } else if (w != parent[v]) {
+            low[v] = std::min(low[v], disc[w]);
+          }
+          continue;
+        }
+
+        stack.pop_back();
+        int p = parent[v];
+        if (p != -1) {
+          low[p] = std::min(low[p], low[v]);
+          if (low[v] > disc[p]) bridges.emplace_back(std::min(p, v), std::max(p, v));
+        }
+      }
+    }
+
+    std::sort(bridges.begin(), bridges.end());
+    return bridges;
+  }
+
+  /// @brief Builds the graph and fills the answers. Bridges are normalized and sorted here
+  Response<FamilyGraph> __finish(std::string name, const CsrGraph& csrGraph, EdgeVector bridges) {
+    FamilyGraph family;
+    family.name = std::move(name);
+    family.graph = csrGraph.toGraph();
+
+    for (auto& [u, v] : bridges) {
+      if (u > v) std::swap(u, v);
+    }
+    std::sort(bridges.begin(), bridges.end());
+    family.bridges = std::move(bridges);
+
+    for (int v = 0; v < csrGraph.V; v++) {
+      if (csrGraph.getEdgeQuantity(v) % 2 != 0) family.oddVertices++;
+    }
+
+    return Response<FamilyGraph>(std::move(family));
+  }
+
+  Response<FamilyGraph> __finish(std::string name, int n, const EdgeVector& edges, EdgeVector bridges) {
+    return __finish(std::move(name), csr::buildSymmetric(n, edges), std::move(bridges));
+  }
+
+  bool __fitsVertexRange(long long n) {
+    return n >= 1 && n <= std::numeric_limits<int>::max();
+  }
+
+  /// @brief Appends the cycle first, first+1, ..., first+length-1, first
+  void __addCycle(int first, int length, EdgeVector& edges) {
+    for (int i = 1; i < length; i++) {
+      edges.emplace_back(first + i - 1, first + i);
+    }
+    edges.emplace_back(first + length - 1, first);
+  }
+
+
+  //---- Famílias ----//
+
+  Response<FamilyGraph> rmat(int scale, int edgeFactor, uint64_t seed, double a, double b, double c) {
+    if (scale < 1 || scale > 30 || edgeFactor < 1 || a < 0 || b < 0 || c < 0 || a + b + c > 1.0) {
+      return Response<FamilyGraph>(ErrorCode::INVALID_ARGUMENT, "Invalid R-MAT parameters");
+    }
+
+    int n = 1 << scale;
+    size_t draws = static_cast<size_t>(edgeFactor) * n;
+    rng::Xoshiro256 random(seed);
+
+    EdgeVector edges;
+    edges.reserve(draws + n);
+    for (size_t e = 0; e < draws; e++) {
+      int u = 0, v = 0;
+      for (int bit = scale - 1; bit >= 0; bit--) {
+        double r = random.uniform();
+        if (r < a) {
+          // Top left, both bits stay 0
+        } else if (r < a + b) {
+          v |= 1 << bit;
+        } else if (r < a + b + c) {
+          u |= 1 << bit;
+        } else {
+          u |= 1 << bit;
+          v |= 1 << bit;
+        }
+      }
+      edges.emplace_back(u, v);
+    }
+
+    csr::BuildOptions options;
+    options.dedupe = true;
+    options.dropSelfLoops = true;
+    CsrGraph sampled = csr::buildSymmetric(n, edges, options);
+
+    // Components by BFS, then one edge from each of them to the largest
+    std::vector<int> component(n, -1), queue;
+    std::vector<int> representative;
+    std::vector<size_t> componentSize;
+    queue.reserve(n);
+    for (int root = 0; root < n; root++) {
+      if (component[root] != -1) continue;
+
+      int id = static_cast<int>(representative.size());
+      representative.push_back(root);
+      queue.clear();
+      queue.push_back(root);
+      component[root] = id;
+      for (size_t head = 0; head < queue.size(); head++) {
+        for (int w : sampled.neighbours(queue[head])) {
+          if (component[w] == -1) {
+            component[w] = id;
+            queue.push_back(w);
+          }
+        }
+      }
+      componentSize.push_back(queue.size());
+    }
+
+    int largest = static_cast<int>(std::max_element(componentSize.begin(), componentSize.end()) - componentSize.begin());
+    std::vector<int> largestVertices;
+    largestVertices.reserve(componentSize[largest]);
+    for (int v = 0; v < n; v++) {
+      if (component[v] == largest) largestVertices.push_back(v);
+    }
+
+    edges.clear();
+    for (int v = 0; v < n; v++) {
+      for (int w : sampled.neighbours(v)) {
+        if (v < w) edges.emplace_back(v, w);
+      }
+    }
+    for (int id = 0; id < static_cast<int>(representative.size()); id++) {
+      if (id == largest) continue;
+      edges.emplace_back(representative[id], largestVertices[random.below(largestVertices.size())]);
+    }
+
+    CsrGraph connected = csr::buildSymmetric(n, edges);
+    EdgeVector bridges = __findBridges(connected);
+    return __finish("rmat-" + std::to_string(scale) + "-" + std::to_string(edgeFactor), connected, std::move(bridges));
+  }
+
+
+  Response<FamilyGraph> grid(int rows, int cols) {
+    if (rows < 1 || cols < 1 || !__fitsVertexRange(static_cast<long long>(rows) * cols)) {
+      return Response<FamilyGraph>(ErrorCode::INVALID_ARGUMENT, "Invalid grid dimensions");
+    }
+
+    int n = rows * cols;
+    EdgeVector edges;
+    edges.reserve(2 * static_cast<size_t>(n));
+    for (int r = 0; r < rows; r++) {
+      for (int c = 0; c < cols; c++) {
+        int v = r * cols + c;
+        if (c + 1 < cols) edges.emplace_back(v, v + 1);
+        if (r + 1 < rows) edges.emplace_back(v, v + cols);
+      }
+    }
+
+    // A single row or column is a path
+    EdgeVector bridges;
+    if (rows == 1 || cols == 1) bridges = edges;
+
+    return __finish("grid-" + std::to_string(rows) + "x" + std::to_string(cols), n, edges, std::move(bridges));
+  }
+
+
+  Response<FamilyGraph> cactus(int cycles, int cycleLength, float bridgeChance, uint64_t seed) {
+    long long maxVertices = 1 + static_cast<long long>(cycles) * cycleLength;
+    if (cycles < 1 || cycleLength < 3 || !__fitsVertexRange(maxVertices)) {
+      return Response<FamilyGraph>(ErrorCode::INVALID_ARGUMENT, "Invalid cactus parameters");
+    }
+
+    rng::Xoshiro256 random(seed);
+    EdgeVector edges, bridges;
+    int n = 1;
+
+    for (int i = 0; i < cycles; i++) {
+      int anchor = static_cast<int>(random.below(n));
+
+      if (random.uniform() < bridgeChance) {
+        bridges.emplace_back(anchor, n);
+        edges.emplace_back(anchor, n);
+        anchor = n++;
+      }
+
+      // anchor plus cycleLength - 1 new vertices
+      edges.emplace_back(anchor, n);
+      for (int k = 1; k < cycleLength - 1; k++) {
+        edges.emplace_back(n + k - 1, n + k);
+      }
+      edges.emplace_back(n + cycleLength - 2, anchor);
+      n += cycleLength - 1;
+    }
+
+    return __finish("cactus-" + std::to_string(cycles) + "-" + std::to_string(cycleLength), n, edges, std::move(bridges));
+  }
+
+
+  Response<FamilyGraph> blockChain(int blocks, int blockSize, float chordChance, uint64_t seed) {
+    if (blocks < 1 || blockSize < 3 || !__fitsVertexRange(static_cast<long long>(blocks) * blockSize)) {
+      return Response<FamilyGraph>(ErrorCode::INVALID_ARGUMENT, "Invalid block chain parameters");
+    }
+
+    rng::Xoshiro256 random(seed);
+    int n = blocks * blockSize;
+    int chords = static_cast<int>(chordChance * blockSize);
+    EdgeVector edges, bridges;
+
+    for (int i = 0; i < blocks; i++) {
+      int first = i * blockSize;
+      __addCycle(first, blockSize, edges);
+
+      // Chords never break 2-edge-connectivity, repeated or cycle edges are skipped
+      for (int k = 0; k < chords; k++) {
+        int u = static_cast<int>(random.below(blockSize));
+        int v = static_cast<int>(random.below(blockSize));
+        int gap = std::abs(u - v);
+        if (gap < 2 || gap == blockSize - 1) continue;
+        edges.emplace_back(first + u, first + v);
+      }
+
+      if (i > 0) {
+        int u = first - blockSize + static_cast<int>(random.below(blockSize));
+        int v = first + static_cast<int>(random.below(blockSize));
+        edges.emplace_back(u, v);
+        bridges.emplace_back(u, v);
+      }
+    }
+
+    csr::BuildOptions options;
+    options.dedupe = true;
+    return __finish("blockchain-" + std::to_string(blocks) + "x" + std::to_string(blockSize),
+                    csr::buildSymmetric(n, edges, options), std::move(bridges));
+  }
+
+
+  Response<FamilyGraph> barbell(int cliqueSize, int pathLength) {
+    long long n = 2LL * cliqueSize + pathLength - 1;
+    if (cliqueSize < 3 || pathLength < 1 || !__fitsVertexRange(n)) {
+      return Response<FamilyGraph>(ErrorCode::INVALID_ARGUMENT, "Invalid barbell parameters");
+    }
+
+    // Clique A on [0, k), inner path vertices, clique B on the last k vertices
+    int secondClique = cliqueSize + pathLength - 1;
+    EdgeVector edges, bridges;
+    for (int first : {0, secondClique}) {
+      for (int u = first; u < first + cliqueSize; u++) {
+        for (int v = u + 1; v < first + cliqueSize; v++) edges.emplace_back(u, v);
+      }
+    }
+    for (int v = cliqueSize - 1; v < secondClique; v++) {
+      edges.emplace_back(v, v + 1);
+      bridges.emplace_back(v, v + 1);
+    }
+
+    return __finish("barbell-" + std::to_string(cliqueSize) + "-" + std::to_string(pathLength),
+                    static_cast<int>(n), edges, std::move(bridges));
+  }
+
+
+  Response<FamilyGraph> star(int n) {
+    if (n < 1) return Response<FamilyGraph>(ErrorCode::INVALID_ARGUMENT, "Invalid star size");
+
+    EdgeVector edges;
+    edges.reserve(n - 1);
+    for (int v = 1; v < n; v++) edges.emplace_back(0, v);
+
+    EdgeVector bridges = edges;
+    return __finish("star-" + std::to_string(n), n, edges, std::move(bridges));
+  }
+
+
+  Response<FamilyGraph> deepPath(int n) {
+    if (n < 1) return Response<FamilyGraph>(ErrorCode::INVALID_ARGUMENT, "Invalid path size");
+
+    EdgeVector edges;
+    edges.reserve(n - 1);
+    for (int v = 1; v < n; v++) edges.emplace_back(v - 1, v);
+
+    EdgeVector bridges = edges;
+    return __finish("path-" + std::to_string(n), n, edges, std::move(bridges));
+  }
+}
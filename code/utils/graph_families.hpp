@@ -0,0 +1,76 @@
+#ifndef GRAPH_FAMILIES_HPP
+#define GRAPH_FAMILIES_HPP
+
+#include "graph.hpp"
+#include "response_struct.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+/**
+ * @brief Structured and scale-free benchmark graphs with known answers
+ *
+ * Random graphs from randomgraph are almost 2-edge-connected, so they rarely produce a
+ * bridge. These families cover very different shapes (hubs, long DFS chains, many or
+ * no bridges), and every generator returns the exact bridge set and Eulerian status,
+ * so benchmarks can check the engines while timing them.
+ *
+ * Every graph is connected and simple. Randomized families take a seed and always
+ * return the same graph for it.
+ */
+namespace graphfamily {
+
+    struct FamilyGraph {
+        std::string name;
+        Graph graph;
+        EdgeVector bridges;   // Every bridge as (min, max), sorted
+        int oddVertices = 0;  // Vertices with odd degree
+
+        bool hasEulerianCircuit() const { return oddVertices == 0; }
+        bool hasEulerianPath() const { return oddVertices == 0 || oddVertices == 2; }
+    };
+
+    /**
+     * @brief R-MAT (Kronecker) power-law graph over 2^scale vertices
+     *
+     * edgeFactor * 2^scale pairs are drawn by recursively choosing a quadrant of the
+     * adjacency matrix with probabilities a, b, c and 1 - a - b - c. Self-loops and repeated
+     * pairs are removed, then every component is attached to the largest one by a single
+     * edge (isolated vertices become pendant leaves). Bridges are computed exactly on the
+     * result with an iterative low-link pass, independent from the engines under test.
+     */
+    Response<FamilyGraph> rmat(int scale, int edgeFactor, uint64_t seed,
+                               double a = 0.57, double b = 0.19, double c = 0.19);
+
+    /// @brief rows x cols lattice. Bridge free unless one of the sides is 1 (a path)
+    Response<FamilyGraph> grid(int rows, int cols);
+
+    /**
+     * @brief Cactus made of cycles hung on random vertices of the previous ones
+     *
+     * With probability bridgeChance a cycle hangs from a new pendant edge instead of
+     * sharing the vertex, those edges are the only bridges.
+     */
+    Response<FamilyGraph> cactus(int cycles, int cycleLength, float bridgeChance, uint64_t seed);
+
+    /**
+     * @brief Chain of 2-edge-connected blocks, consecutive blocks joined by one bridge
+     *
+     * Every block is a cycle of blockSize vertices plus about chordChance * blockSize random chords.
+     */
+    Response<FamilyGraph> blockChain(int blocks, int blockSize, float chordChance, uint64_t seed);
+
+    /// @brief Two cliques of cliqueSize vertices joined by a path of pathLength edges (all bridges)
+    Response<FamilyGraph> barbell(int cliqueSize, int pathLength);
+
+    /// @brief Vertex 0 linked to n-1 leaves, every edge is a bridge
+    Response<FamilyGraph> star(int n);
+
+    /// @brief Path 0-1-...-(n-1), DFS from 0 reaches depth n. Every edge is a bridge
+    Response<FamilyGraph> deepPath(int n);
+}
+
+
+#endif  // GRAPH_FAMILIES_HPP
@@ -0,0 +1,217 @@
+#include "perf_counters.hpp"
+#include "alloc_tracker.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+namespace perfcounters {
+
+  const char* counterName(int counter) {
+    switch (counter) {
+      case CYCLES: return "cycles";
+      case INSTRUCTIONS: return "instructions";
+      case LLC_MISSES: return "llc_misses";
+      case DTLB_MISSES: return "dtlb_misses";
+      case BRANCH_MISSES: return "branch_misses";
+      default: return "unknown";
+    }
+  }
+
+  CounterSample& CounterSample::operator+=(const CounterSample& other) {
+    micro += other.micro;
+    for (int i = 0; i < COUNTER_QUANTITY; i++) {
+      values[i] += other.values[i];
+      available[i] = other.available[i];
+    }
+
+    memory = other.memory;
+    allocations += other.allocations;
+    allocatedBytes += other.allocatedBytes;
+    heapPeak = std::max(heapPeak, other.heapPeak);
+    rssPeak = std::max(rssPeak, other.rssPeak);
+    return *this;
+  }
+
+  double __elapsedMicro(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+  }
+
+
+  //---- Contadores ----//
+
+#ifdef __linux__
+
+  // Returns -1 and keeps errno when the event cannot be opened
+  int __openCounter(uint32_t type, uint64_t config) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+  }
+
+  uint64_t __cacheConfig(uint64_t cache) {
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+  }
+
+  CounterSet::CounterSet(bool enabled) {
+    for (int i = 0; i < COUNTER_QUANTITY; i++) fds[i] = -1;
+    if (!enabled) {
+      failure = "disabled";
+      return;
+    }
+
+    const uint32_t types[COUNTER_QUANTITY] = {
+      PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE
+    };
+    const uint64_t configs[COUNTER_QUANTITY] = {
+      PERF_COUNT_HW_CPU_CYCLES,
+      PERF_COUNT_HW_INSTRUCTIONS,
+      __cacheConfig(PERF_COUNT_HW_CACHE_LL),
+      __cacheConfig(PERF_COUNT_HW_CACHE_DTLB),
+      PERF_COUNT_HW_BRANCH_MISSES
+    };
+
+    for (int i = 0; i < COUNTER_QUANTITY; i++) {
+      fds[i] = __openCounter(types[i], configs[i]);
+      if (fds[i] == -1 && failure.empty()) {
+        failure = std::string("perf_event_open(") + counterName(i) + "): " + std::strerror(errno);
+      }
+    }
+  }
+
+  CounterSet::~CounterSet() {
+    for (int i = 0; i < COUNTER_QUANTITY; i++) {
+      if (fds[i] != -1) close(fds[i]);
+    }
+  }
+
+  void CounterSet::start() {
+    for (int i = 0; i < COUNTER_QUANTITY; i++) {
+      if (fds[i] == -1) continue;
+      ioctl(fds[i], PERF_EVENT_IOC_RESET, 0);
+      ioctl(fds[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+    begin = std::chrono::steady_clock::now();
+  }
+
+  CounterSample CounterSet::stop() {
+    CounterSample sample;
+    sample.micro = __elapsedMicro(begin);
+
+    for (int i = 0; i < COUNTER_QUANTITY; i++) {
+      if (fds[i] == -1) continue;
+      ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+
+      uint64_t data[3];  // value, time enabled, time running
+      if (read(fds[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) continue;
+
+      sample.available[i] = true;
+      sample.values[i] = data[2] == 0 || data[2] >= data[1]
+        ? data[0]
+        : static_cast<uint64_t>(static_cast<double>(data[0]) * data[1] / data[2]);
+    }
+    return sample;
+  }
+
+#else
+
+  CounterSet::CounterSet(bool enabled) {
+    for (int i = 0; i < COUNTER_QUANTITY; i++) fds[i] = -1;
+    failure = enabled ? "hardware counters are only supported on Linux" : "disabled";
+  }
+
+  CounterSet::~CounterSet() {}
+
+  void CounterSet::start() {
+    begin = std::chrono::steady_clock::now();
+  }
+
+  CounterSample CounterSet::stop() {
+    CounterSample sample;
+    sample.micro = __elapsedMicro(begin);
+    return sample;
+  }
+
+#endif
+
+  bool CounterSet::anyAvailable() const {
+    for (int i = 0; i < COUNTER_QUANTITY; i++) {
+      if (fds[i] != -1) return true;
+    }
+    return false;
+  }
+
+
+  //---- Fases ----//
+
+  CounterSample Phase::average() const {
+    CounterSample sample = total;
+    if (calls <= 1) return sample;
+
+    sample.micro /= calls;
+    for (int i = 0; i < COUNTER_QUANTITY; i++) sample.values[i] /= calls;
+    sample.allocations /= calls;
+    sample.allocatedBytes /= calls;
+    return sample;
+  }
+
+  void PhaseRecorder::start(const std::string& name) {
+    open = -1;
+    for (size_t i = 0; i < recorded.size(); i++) {
+      if (recorded[i].name == name) open = static_cast<int>(i);
+    }
+    if (open == -1) {
+      recorded.push_back(Phase{name, 0, CounterSample()});
+      open = static_cast<int>(recorded.size()) - 1;
+    }
+
+    if (alloctracker::enabled()) {
+      alloctracker::resetPeakRss();
+      alloctracker::resetPeak();
+      alloctracker::AllocStats heap = alloctracker::snapshot();
+      liveAtStart = heap.liveBytes;
+      allocationsAtStart = heap.allocations;
+      bytesAtStart = heap.allocatedBytes;
+    }
+
+    if (counters != nullptr) counters->start();
+    else begin = std::chrono::steady_clock::now();
+  }
+
+  void PhaseRecorder::stop() {
+    if (open == -1) return;
+
+    CounterSample sample;
+    if (counters != nullptr) sample = counters->stop();
+    else sample.micro = __elapsedMicro(begin);
+
+    if (alloctracker::enabled()) {
+      alloctracker::AllocStats heap = alloctracker::snapshot();
+      sample.memory = true;
+      sample.allocations = heap.allocations - allocationsAtStart;
+      sample.allocatedBytes = heap.allocatedBytes - bytesAtStart;
+      sample.heapPeak = heap.peakBytes > liveAtStart ? heap.peakBytes - liveAtStart : 0;
+      sample.rssPeak = alloctracker::peakRssBytes();
+    }
+
+    recorded[open].total += sample;
+    recorded[open].calls++;
+    open = -1;
+  }
+}
@@ -0,0 +1,129 @@
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+/**
+ * @brief Hardware performance counters per named phase of an algorithm
+ *
+ * On Linux the counters are opened with perf_event_open for the calling thread, user space
+ * only (works with perf_event_paranoid <= 2). Counters that the kernel, the CPU or the
+ * virtual machine does not provide are marked unavailable and only the wall time is kept,
+ * so the same code runs everywhere and simply reports less.
+ *
+ * Values are scaled by time_enabled / time_running when the kernel multiplexes counters.
+ *
+ * When alloctracker is enabled the phases also record heap allocations and the peak
+ * resident set size, see alloc_tracker.hpp.
+ */
+namespace perfcounters {
+
+    enum Counter {
+        CYCLES,
+        INSTRUCTIONS,
+        LLC_MISSES,     // Last level cache read misses
+        DTLB_MISSES,    // Data TLB read misses
+        BRANCH_MISSES,
+        COUNTER_QUANTITY
+    };
+
+    const char* counterName(int counter);
+
+    struct CounterSample {
+        double micro = 0;
+        uint64_t values[COUNTER_QUANTITY] = {};
+        bool available[COUNTER_QUANTITY] = {};
+
+        bool memory = false;          // Heap fields below were recorded
+        uint64_t allocations = 0;
+        uint64_t allocatedBytes = 0;
+        uint64_t heapPeak = 0;        // Highest live heap above the start of the phase
+        uint64_t rssPeak = 0;         // Highest resident set size of the process during the phase
+
+        /// @brief Sums the counters, peaks keep the maximum
+        CounterSample& operator+=(const CounterSample& other);
+    };
+
+
+    /**
+     * @brief Group of counters opened once and reused by every start()/stop() pair
+     *
+     * Only the thread that constructed it is measured. Not copyable, file descriptors
+     * are closed on destruction.
+     */
+    class CounterSet {
+      private:
+        int fds[COUNTER_QUANTITY];
+        std::string failure;
+        std::chrono::steady_clock::time_point begin;
+
+      public:
+        /// @brief `enabled` false skips perf_event_open, leaving a timer only set
+        explicit CounterSet(bool enabled = true);
+        ~CounterSet();
+
+        CounterSet(const CounterSet&) = delete;
+        CounterSet& operator=(const CounterSet&) = delete;
+
+        bool available(int counter) const { return fds[counter] != -1; }
+        bool anyAvailable() const;
+
+        /// @brief Why counters are missing, empty when all of them opened
+        const std::string& status() const { return failure; }
+
+        void start();
+        CounterSample stop();
+    };
+
+
+    struct Phase {
+        std::string name;
+        int calls = 0;
+        CounterSample total;
+
+        /// @brief Values divided by the number of calls, peaks are the maximum among them
+        CounterSample average() const;
+    };
+
+    /**
+     * @brief Accumulates counters of named phases, in order of first appearance
+     *
+     * Phases do not nest: start() of a new phase while another is open is an error of the
+     * caller. A null CounterSet records wall time only.
+     */
+    class PhaseRecorder {
+      private:
+        CounterSet *counters;
+        std::vector<Phase> recorded;
+        int open = -1;
+        std::chrono::steady_clock::time_point begin;
+        uint64_t liveAtStart = 0, allocationsAtStart = 0, bytesAtStart = 0;
+
+      public:
+        explicit PhaseRecorder(CounterSet *counters = nullptr) : counters(counters) {}
+
+        void start(const std::string& name);
+        void stop();
+
+        const std::vector<Phase>& phases() const { return recorded; }
+        void clear() { recorded.clear(); open = -1; }
+
+        /// @brief Stops the phase when leaving the scope
+        class Scope {
+          private:
+            PhaseRecorder *recorder;
+          public:
+            Scope(PhaseRecorder& recorder, const std::string& name) : recorder(&recorder) { recorder.start(name); }
+            ~Scope() { recorder->stop(); }
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+        };
+    };
+}
+
+
+#endif  // PERF_COUNTERS_HPP
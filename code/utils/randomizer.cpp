@@ -1,14 +1,18 @@
 #include "randomizer.hpp"
 #include "graph.hpp"
+#include "csr_graph.hpp"
 #include "response_struct.hpp"
+#include "rng.hpp"
+#include "scheduler.hpp"
 
 #include <algorithm>
 #include <sstream>
 #include <random>
 #include <variant>
 #include <cstring>
-#include <unordered_set>
 #include <vector>
+#include <cstdlib>
+#include <cmath>
 
 namespace randomgraph {
   // Global random generator, seeded once
@@ -58,23 +62,18 @@ namespace randomgraph {
   }
 
 
-  int __connectEmptyGraph(Graph& graph, std::unordered_set<std::pair<int, int>, pair_hash>& addedEdges) {
-    int n = graph.adj.size();
-    
-    int *array = new int[n];
+  int __connectEmptyGraph(int n, EdgeVector& edges, std::vector<int>& position) {
+    std::vector<int> array(n);
     for (int i = 0; i < n; i++) {
       array[i] = i;
     }
     
-    std::shuffle(array,array+n, gen);
+    std::shuffle(array.begin(), array.end(), gen);
 
-    for (int *it = array+1; it < array+n; it++) {
-      int u = *(it-1);
-      int v = *it;
-      graph.addEdge(u, v);
-
-      addedEdges.insert({u, v});
-      addedEdges.insert({v, u});
+    position.resize(n);
+    for (int i = 0; i < n; i++) {
+      position[array[i]] = i;
+      if (i > 0) edges.emplace_back(array[i - 1], array[i]);
     }
 
     // Return last element
@@ -90,38 +89,40 @@ namespace randomgraph {
       std::ostringstream ss;
       ss << "EXCEEDED MAXIMUM SIZE (120MB) ALLOWED FOR NORMAL USE, EXPECTED: " 
       << valueInMB << "[MB] ON END OF OPERATION" << std::endl;
-      return Response<int>(std::move(ss.str()), 0);
+      return Response<int>(ErrorCode::SIZE_LIMIT, ss.str());
     }
-    return Response<int>(extraEdges);
+    return Response<int>(std::move(extraEdges));
   }
 
 
   // LIMIT of 10MB edges (Each edge is stored on linked blocks of 12 so that would give 120MB max)
   Response<Graph> createConectedGraph(int n, int edges) {
     Response<int> res = __calculateExtraEdges(n, edges);
-    if (!res.isOk()) return Response<Graph>(std::move(res.message), {});
+    if (!res.isOk()) return Response<Graph>(res.code, std::move(res.message));
+    if (n < 2) return Response<Graph>(Graph(std::max(n, 0)));
 
-    int extraEdges = res.value;
-    Graph graph(n);  
-    std::unordered_set<std::pair<int, int>, pair_hash> edgeSet;
-    edgeSet.reserve(edges);
-    
-    __connectEmptyGraph(graph, edgeSet);
-
-    std::uniform_int_distribution<int> dis(0, n-1);
-
-    while (extraEdges > 0) {
-      int u = dis(gen);
-      int v = dis(gen);
-      if (u != v && edgeSet.find({u, v}) == edgeSet.end()) {
-        graph.addEdge(u, v);
-        edgeSet.insert({u, v});
-        edgeSet.insert({v, u});
-        extraEdges--;
-      }
+    int extraEdges = std::max(res.value, 0);
+    EdgeVector edgeList;
+    edgeList.reserve(n - 1 + extraEdges);
+
+    std::vector<int> order(n);
+    for (int i = 0; i < n; i++) {
+      order[i] = i;
     }
+    std::shuffle(order.begin(), order.end(), gen);
 
-    return Response<Graph>(std::move(graph));
+    // Extra edges are positions on the path at distance >= 2, so they never repeat a path edge
+    for (int i = 1; i < n; i++) {
+      edgeList.emplace_back(i - 1, i);
+    }
+    sampleGnmPairs(n, extraEdges, 2, edgeList);
+
+    for (auto& [u, v] : edgeList) {
+      u = order[u];
+      v = order[v];
+    }
+
+    return Response<Graph>(csr::buildSymmetric(n, edgeList).toGraph());
   }
 
   Response<Graph> createConectedGraph(int n, float edgePercentage) {
@@ -130,33 +131,39 @@ namespace randomgraph {
   }
 
 
+  Response<void> __fixDegreeParity(Graph& graph, const std::vector<int>& position);
+
   Response<Graph> createEulerianGraph(int n, int edges) {
     Response<int> res = __calculateExtraEdges(n, edges);
-    if (!res.isOk()) return Response<Graph>(std::move(res.message), {});
-
-    int extraEdges = res.value;
-    Graph graph(n);  
-    std::unordered_set<std::pair<int, int>, pair_hash> edgeSet;
-    edgeSet.reserve(edges);
-    
-    int u = __connectEmptyGraph(graph, edgeSet);
-
-    //std::cout << extraEdges << std::endl;
-
-    std::uniform_int_distribution<int> dis(0, n-1);
+    if (!res.isOk()) return Response<Graph>(res.code, std::move(res.message));
+    if (n < 2) return Response<Graph>(Graph(std::max(n, 0)));
+
+    int extraEdges = std::max(res.value, 0);
+    EdgeVector edgeList;
+    edgeList.reserve(n - 1 + extraEdges);
+
+    std::vector<int> position;
+    __connectEmptyGraph(n, edgeList, position);
+    std::vector<int> order(n);
+    for (int v = 0; v < n; v++) {
+      order[position[v]] = v;
+    }
 
-    while (extraEdges > 0) {
-      int v = dis(gen);
-      //std::cout << "V: " << v << std::endl;
-      if (u != v && edgeSet.find({u, v}) == edgeSet.end()) {
-        graph.addEdge(u, v);
-        edgeSet.insert({u, v});
-        edgeSet.insert({v, u});
-        extraEdges--;
-        u = v;
-      }
+    // Extra edges are positions on the path at distance >= 2, so they never repeat a path edge
+    size_t first = edgeList.size();
+    sampleGnmPairs(n, extraEdges, 2, edgeList);
+    for (size_t k = first; k < edgeList.size(); k++) {
+      edgeList[k] = {order[edgeList[k].first], order[edgeList[k].second]};
     }
 
+    // Pairs are already distinct, dedupe only marks the lists so the parity fix finds edges fast
+    csr::BuildOptions build;
+    build.dedupe = true;
+    Graph graph = csr::buildSymmetric(n, edgeList, build).toGraph();
+    EdgeVector().swap(edgeList);
+
+    Response<void> fixed = __fixDegreeParity(graph, position);
+    if (!fixed.isOk()) return Response<Graph>(fixed.code, std::move(fixed.message));
     return Response<Graph>(std::move(graph));
   }
 
@@ -168,26 +175,326 @@ namespace randomgraph {
 
 
 
-  // Does not get stuck waiting for valid random number, but runs on all possible edges of the graph
+  // Does not get stuck waiting for valid random number, skips straight to the chosen pairs
   Graph bruteForceCreateConnected(int n, float edgeProbability) {
-    Graph graph(n);
+    EdgeVector edges;
 
     // Add minimum requirement
     for (int i = 1; i < n; i++) {
-      graph.addEdge(i - 1, i); 
+      edges.emplace_back(i - 1, i); 
+    }
+
+    sampleGnpPairs(n, edgeProbability, 2, edges);
+
+    return csr::buildSymmetric(n, edges).toGraph();
+  }
+
+
+  //---- Geometric skip sampling ----//
+
+  // Valid pairs of row j are i = 0 ... j - minGap
+  long long __gapPairQuantity(long long n, long long minGap) {
+    long long rows = n - minGap;
+    return rows > 0 ? rows * (rows + 1) / 2 : 0;
+  }
+
+  void sampleGnpPairs(int n, double p, int minGap, EdgeVector& out) {
+    minGap = std::max(minGap, 1);
+    if (p <= 0.0 || n <= minGap) return;
+
+    if (p >= 1.0) {
+      for (int j = minGap; j < n; j++) {
+        for (int i = 0; i + minGap <= j; i++) out.emplace_back(i, j);
+      }
+      return;
+    }
+
+    std::uniform_real_distribution<double> dis(0.0, 1.0);
+    const double logq = std::log1p(-p);
+    const double total = static_cast<double>(__gapPairQuantity(n, minGap));
+
+    long long j = minGap, i = -1;
+    while (j < n) {
+      // Pairs skipped before the next chosen one, geometric with parameter p
+      double skip = std::floor(std::log1p(-dis(gen)) / logq);
+      if (skip >= total) break;
+
+      i += 1 + static_cast<long long>(skip);
+      while (j < n && i > j - minGap) {
+        i -= j - minGap + 1;
+        j++;
+      }
+      if (j < n) out.emplace_back(static_cast<int>(i), static_cast<int>(j));
+    }
+  }
+
+  void sampleGnmPairs(int n, long long m, int minGap, EdgeVector& out) {
+    minGap = std::max(minGap, 1);
+    long long total = __gapPairQuantity(n, minGap);
+    if (m <= 0 || total == 0) return;
+    if (m >= total) {
+      sampleGnpPairs(n, 1.0, minGap, out);
+      return;
+    }
+
+    // G(n,p') conditioned on having at least m pairs, reduced to a uniform m-subset,
+    // is a uniform m-subset of all pairs. The margin makes retries rare
+    size_t start = out.size();
+    double margin = 3.0;
+    while (true) {
+      double p = (m + margin * std::sqrt(static_cast<double>(m)) + 8.0) / static_cast<double>(total);
+      sampleGnpPairs(n, std::min(p, 1.0), minGap, out);
+      if (static_cast<long long>(out.size() - start) >= m) break;
+
+      out.resize(start);
+      margin *= 2.0;
+    }
+
+    // Partial Fisher-Yates, keeps the first m of a uniform permutation
+    size_t sampled = out.size() - start;
+    for (size_t k = 0; k < static_cast<size_t>(m); k++) {
+      std::uniform_int_distribution<size_t> pick(k, sampled - 1);
+      std::swap(out[start + k], out[start + pick(gen)]);
+    }
+    out.resize(start + m);
+  }
+
+
+
+  //---- Reproducible generators ----//
+
+  // Expected sampled pairs on each key range, every range reads its own random stream
+  const size_t GENERATOR_BLOCK = 1 << 16;
+
+  unsigned __generatorThreads(const GeneratorOptions& options, size_t blocks) {
+    unsigned threads = options.threads != 0 ? options.threads : sched::threadCount();
+    threads = std::max(1u, threads);
+    return static_cast<unsigned>(std::min<size_t>(threads, std::max<size_t>(blocks, 1)));
+  }
+
+  // Pair keys: pairs u < v on row-major order, row u holds the n-1-u keys of (u, u+1 ... n-1)
+  uint64_t __rowStart(uint64_t n, uint64_t u) {
+    return u * (2 * n - u - 1) / 2;
+  }
+
+  std::pair<int, int> __pairOfKey(uint64_t n, uint64_t key) {
+    // Largest u with rowStart(u) <= key, from the quadratic formula and fixed for rounding
+    double b = 2.0 * static_cast<double>(n) - 1.0;
+    double root = (b - std::sqrt(std::max(b * b - 8.0 * static_cast<double>(key), 0.0))) / 2.0;
+    uint64_t u = std::min<uint64_t>(static_cast<uint64_t>(std::max(root, 0.0)), n - 2);
+    while (u > 0 && __rowStart(n, u) > key) u--;
+    while (u + 2 < n && __rowStart(n, u + 1) <= key) u++;
+    return {static_cast<int>(u), static_cast<int>(u + 1 + (key - __rowStart(n, u)))};
+  }
+
+  /**
+   * @brief Appends the keys of a G(n,p) sample of the pairs off the spanning path
+   *
+   * The key range is split in `blocks` fixed ranges, each visited with geometric skipping.
+   * Range b reads stream b of `base` (base jumped b+1 times), task t takes ranges t, t+T...
+   * and keeps one stream jumping forward, so the keys never depend on the task count.
+   * Keys come out in increasing order. `base` ends jumped past the streams used.
+   */
+  void __sampleSeededKeys(int n, double p, size_t blocks, const std::vector<int>& position, unsigned threads,
+                          rng::Xoshiro256& base, std::vector<uint64_t>& out) {
+    const uint64_t total = static_cast<uint64_t>(n) * (n - 1) / 2;
+    const uint64_t width = (total + blocks - 1) / blocks;
+    const double logq = std::log1p(-p);
+    std::vector<std::vector<uint64_t>> sampled(blocks);
+
+    auto work = [&](unsigned t) {
+      rng::Xoshiro256 stream = base;
+      for (unsigned j = 0; j <= t; j++) stream.jump();
+
+      for (size_t block = t; block < blocks; block += threads) {
+        rng::Xoshiro256 random = stream;
+        uint64_t key = block * width, end = std::min(total, key + width);
+        std::vector<uint64_t>& keys = sampled[block];
+        keys.reserve(static_cast<size_t>(p * (end - key) * 1.05) + 16);
+
+        while (key < end) {
+          // Pairs skipped before the next chosen one, geometric with parameter p
+          double skip = std::floor(std::log1p(-random.uniform()) / logq);
+          if (skip >= static_cast<double>(end - key)) break;
+          key += static_cast<uint64_t>(skip);
+
+          std::pair<int, int> pair = __pairOfKey(n, key);
+          if (std::abs(position[pair.first] - position[pair.second]) != 1) keys.push_back(key);
+          key++;
+        }
+
+        // Skip the streams of the ranges taken by the other tasks
+        if (block + threads < blocks) {
+          for (unsigned j = 0; j < threads; j++) stream.jump();
+        }
+      }
+    };
+    sched::parallelInvoke(threads, work);
+
+    for (const std::vector<uint64_t>& keys : sampled) out.insert(out.end(), keys.begin(), keys.end());
+    for (size_t b = 0; b < blocks; b++) base.jump();
+  }
+
+  /**
+   * @brief Exactly `count` distinct keys of pairs off the spanning path, uniformly chosen, sorted
+   *
+   * G(n,p') conditioned on having at least `count` pairs, reduced to a uniform subset with the
+   * sequential stream `random`, is a uniform count-subset. The margin makes retries rare.
+   */
+  std::vector<uint64_t> __sampleSeededSubset(int n, uint64_t count, const std::vector<int>& position,
+                                             const GeneratorOptions& options, rng::Xoshiro256& random) {
+    std::vector<uint64_t> keys;
+    if (count == 0) return keys;
+
+    const uint64_t available = static_cast<uint64_t>(n) * (n - 1) / 2 - (n - 1);
+    rng::Xoshiro256 base(options.seed);
+    double margin = 3.0;
+    while (true) {
+      double p = std::min(1.0, (count + margin * std::sqrt(static_cast<double>(count)) + 8.0) / static_cast<double>(available));
+      size_t blocks = static_cast<size_t>(std::ceil(p * static_cast<double>(available) / GENERATOR_BLOCK));
+      blocks = std::max<size_t>(blocks, 1);
+      __sampleSeededKeys(n, p, blocks, position, __generatorThreads(options, blocks), base, keys);
+      if (keys.size() >= count) break;
+
+      keys.clear();
+      margin *= 2.0;
+    }
+
+    // Partial Fisher-Yates, keeps the first `count` of a uniform permutation
+    for (uint64_t k = 0; k < count; k++) {
+      std::swap(keys[k], keys[k + random.below(keys.size() - k)]);
+    }
+    keys.resize(count);
+    std::sort(keys.begin(), keys.end());
+    return keys;
+  }
+
+  /**
+   * @brief Toggles edges until every degree is even, see createEulerianGraph
+   *
+   * Odd vertices a and b are paired. Their edge is toggled when it is off the spanning path,
+   * otherwise both edges of a path a - c - b are toggled (c keeps its parity). Path edges are
+   * never removed, so the graph stays connected.
+   */
+  Response<void> __fixDegreeParity(Graph& graph, const std::vector<int>& position) {
+    int n = graph.V;
+    std::vector<int> odd;
+    for (int v = 0; v < n; v++) {
+      if (graph.adj[v].size() % 2 != 0) odd.push_back(v);
     }
 
+    auto backbone = [&](int a, int b) { return std::abs(position[a] - position[b]) == 1; };
+    auto toggle = [&](int a, int b) {
+      if (graph.hasEdge(a, b)) graph.removeEdge(a, b);
+      else graph.addEdge(a, b);
+    };
 
+    size_t half = odd.size() / 2;
+    for (size_t k = 0; k < half; k++) {
+      int a = odd[k], b = odd[k + half];
+
+      if (!backbone(a, b)) {
+        toggle(a, b);
+        continue;
+      }
+
+      // At most four vertices are next to a or b on the path, so only tiny graphs run out of c
+      int c = -1;
+      for (int j = 1; j < n && c == -1; j++) {
+        int candidate = (a + j) % n;
+        if (candidate != b && !backbone(a, candidate) && !backbone(candidate, b)) c = candidate;
+      }
+      if (c == -1) {
+        return Response<void>(ErrorCode::INVALID_ARGUMENT, "No connected Eulerian graph with " + std::to_string(n) + " vertices");
+      }
+      toggle(a, c);
+      toggle(c, b);
+    }
+    return Response<void>();
+  }
+
+  Response<Graph> __createSeededGraph(int n, long long edges, const GeneratorOptions& options, bool eulerian) {
+    if (n < 0) return Response<Graph>(ErrorCode::INVALID_ARGUMENT, "Negative vertex quantity");
+    if (n < 2) return Response<Graph>(Graph(n));
+
+    long long maxEdges = static_cast<long long>(n) * (n - 1) / 2;
+    long long extraEdges = std::min(edges, maxEdges) - (n - 1);
+    if (extraEdges >= EDGELIMIT) {
+      long valueInMB = (extraEdges/BYTE_TO_MB) * 12;
+      std::ostringstream ss;
+      ss << "EXCEEDED MAXIMUM SIZE (120MB) ALLOWED FOR NORMAL USE, EXPECTED: " 
+      << valueInMB << "[MB] ON END OF OPERATION" << std::endl;
+      return Response<Graph>(ErrorCode::SIZE_LIMIT, ss.str());
+    }
+    extraEdges = std::max(extraEdges, 0LL);
+
+    // Stream 0: spanning path over a random permutation
+    rng::Xoshiro256 random(options.seed);
+    std::vector<int> order(n), position(n);
+    for (int i = 0; i < n; i++) order[i] = i;
+    for (int i = n - 1; i > 0; i--) {
+      std::swap(order[i], order[random.below(i + 1)]);
+    }
+
+    EdgeVector pairs;
+    pairs.reserve(n - 1 + extraEdges);
     for (int i = 0; i < n; i++) {
-      for (int j = i + 2; j < n; j++) {
-        if (randomgraph::randomBoolean(edgeProbability)) {
-          graph.addEdge(i, j);
+      position[order[i]] = i;
+      if (i > 0) pairs.emplace_back(order[i - 1], order[i]);
+    }
+
+    // Above half of the pairs off the path, the pairs left out are sampled instead
+    const uint64_t available = static_cast<uint64_t>(maxEdges - (n - 1));
+    const bool complement = static_cast<uint64_t>(extraEdges) > available / 2;
+    std::vector<uint64_t> keys = __sampleSeededSubset(n, complement ? available - extraEdges : extraEdges, position, options, random);
+
+    if (!complement) {
+      for (uint64_t key : keys) pairs.push_back(__pairOfKey(n, key));
+    } else {
+      size_t next = 0;
+      uint64_t key = 0;
+      for (int u = 0; u < n; u++) {
+        for (int v = u + 1; v < n; v++, key++) {
+          if (next < keys.size() && keys[next] == key) {
+            next++;
+          } else if (std::abs(position[u] - position[v]) != 1) {
+            pairs.emplace_back(u, v);
+          }
         }
       }
     }
+    std::vector<uint64_t>().swap(keys);
+
+    // Pairs are already distinct, dedupe only marks the lists so the graph comes out canonical
+    csr::BuildOptions build;
+    build.dedupe = true;
+    build.threads = options.threads;
+    Graph graph = csr::buildSymmetric(n, pairs, build).toGraph();
+    EdgeVector().swap(pairs);
+
+    if (eulerian) {
+      Response<void> fixed = __fixDegreeParity(graph, position);
+      if (!fixed.isOk()) return Response<Graph>(fixed.code, std::move(fixed.message));
+    }
 
-    return graph;
+    return Response<Graph>(std::move(graph));
   }
 
+  Response<Graph> createConectedGraph(int n, long long edges, const GeneratorOptions& options) {
+    return __createSeededGraph(n, edges, options, false);
+  }
+
+  Response<Graph> createConectedGraph(int n, float edgePercentage, const GeneratorOptions& options) {
+    long long edges = static_cast<long long>(static_cast<long long>(n) * (n - 1) / 2 * edgePercentage);
+    return __createSeededGraph(n, edges, options, false);
+  }
 
+  Response<Graph> createEulerianGraph(int n, long long edges, const GeneratorOptions& options) {
+    return __createSeededGraph(n, edges, options, true);
+  }
+
+  Response<Graph> createEulerianGraph(int n, float edgePercentage, const GeneratorOptions& options) {
+    long long edges = static_cast<long long>(static_cast<long long>(n) * (n - 1) / 2 * edgePercentage);
+    return __createSeededGraph(n, edges, options, true);
+  }
 }
\ No newline at end of file
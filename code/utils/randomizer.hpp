@@ -9,8 +9,9 @@
 #include <random>
 #include <variant>
 #include <cstring>
-#include <unordered_set>
+#include <functional>
 #include <vector>
+#include <cstdint>
 
 
 namespace randomgraph {
@@ -21,9 +22,15 @@ namespace randomgraph {
     struct pair_hash {
         template <class T1, class T2>
         std::size_t operator ( ) (const std::pair<T1, T2>& p) const {
-            auto h1 = std::hash<T1>{}(p.first);
-            auto h2 = std::hash<T2>{}(p.second);
-            return h1 ^ h2; // Combine the hashes
+            uint64_t h1 = std::hash<T1>{}(p.first);
+            uint64_t h2 = std::hash<T2>{}(p.second);
+
+            // Order dependent combination followed by a full avalanche, (u,v), (v,u) and (k,k)
+            // must not collide (std::hash<int> is the identity on libstdc++)
+            uint64_t h = h1 * 0x9e3779b97f4a7c15ULL + h2;
+            h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+            return static_cast<std::size_t>(h ^ (h >> 31));
         }
     };
 
@@ -46,14 +53,84 @@ namespace randomgraph {
 
     void makeGraphRandomlyConnected(Graph& graph);
 
-    int __connectEmptyGraph(Graph& graph, std::unordered_set<std::pair<int, int>, pair_hash>& addedEdges);
+    /// @brief Appends a random spanning path over n vertices to edges, returns its last vertex
+    /// position[v] is the place of v along the path
+    int __connectEmptyGraph(int n, EdgeVector& edges, std::vector<int>& position);
 
     Response<Graph> createConectedGraph(int n, int edges);
     Response<Graph> createConectedGraph(int n, float edgePercentage); 
 
+    /**
+     * @brief Connected graph with every degree even (Eulerian circuit)
+     *
+     * Random spanning path plus a G(n,m) sample of the pairs off it (sampleGnmPairs), then
+     * the parity fix of the seeded createEulerianGraph. No hash set and no rejection loop, so
+     * it ends for any density. Fails with INVALID_ARGUMENT when no such graph exists (n = 2).
+     */
     Response<Graph> createEulerianGraph(int n, int edges);
     Response<Graph> createEulerianGraph(int n, float edgePercentage);
 
+    /**
+     * @brief Connected G(n,p): path 0-1-...-(n-1) plus every other pair with probability p
+     *
+     * Extra pairs come from sampleGnpPairs, O(n + m) instead of flipping a coin per pair.
+     */
     Graph bruteForceCreateConnected(int, float edgePercentage);
+
+
+    /**
+     * @brief Appends the pairs (i, j) of a G(n,p) sample with j - i >= minGap
+     *
+     * Batagelj–Brandes geometric skipping: pairs are visited on row-major order (row j,
+     * column i) and the gap to the next chosen pair is drawn directly from the geometric
+     * distribution, so the cost is O(n + m) and every pair comes out at most once (no hash set).
+     * minGap = 2 leaves out the pairs (i, i+1) of a spanning path on the same order.
+     */
+    void sampleGnpPairs(int n, double p, int minGap, EdgeVector& out);
+
+    /**
+     * @brief Appends m distinct pairs (i, j) with j - i >= minGap, uniformly chosen (G(n,m))
+     *
+     * Oversamples with sampleGnpPairs and keeps a uniform subset of exactly m pairs.
+     * When m exceeds the number of valid pairs, every valid pair is appended.
+     */
+    void sampleGnmPairs(int n, long long m, int minGap, EdgeVector& out);
+
+
+    /**
+     * @brief Settings of the reproducible generators
+     *
+     * The same seed always produces the same graph, for any thread count.
+     */
+    struct GeneratorOptions {
+        uint64_t seed = 0;
+        unsigned threads = 0;  // Tasks drawing pairs, 0 uses sched::threadCount()
+    };
+
+    /**
+     * @brief Reproducible, parallel version of createConectedGraph
+     *
+     * A random spanning path (stream 0 of the seed) guarantees connectivity. Extra edges are
+     * a uniform sample without replacement of the pairs off the path: fixed ranges of pair
+     * keys are visited with geometric skipping, range b using the seed jumped b+1 times
+     * (rng::Xoshiro256), so tasks can take any range without changing the result. The
+     * oversample is cut to the exact quantity on stream 0. Above half density the pairs left
+     * out are sampled instead, so the cost stays O(n + m) up to the complete graph.
+     */
+    Response<Graph> createConectedGraph(int n, long long edges, const GeneratorOptions& options);
+    Response<Graph> createConectedGraph(int n, float edgePercentage, const GeneratorOptions& options);
+
+    /**
+     * @brief Reproducible, parallel version of createEulerianGraph
+     *
+     * Same construction as the seeded createConectedGraph, followed by a parity fix: odd
+     * vertices are paired (k-th with (k + K/2)-th) and the edge between them is toggled
+     * (added or removed), toggling both edges through a third vertex instead when that edge
+     * belongs to the spanning path. The result is connected with every degree even (Eulerian
+     * circuit), and may differ from the requested edge quantity by the toggled edges.
+     * Fails with INVALID_ARGUMENT when no such graph exists (n = 2).
+     */
+    Response<Graph> createEulerianGraph(int n, long long edges, const GeneratorOptions& options);
+    Response<Graph> createEulerianGraph(int n, float edgePercentage, const GeneratorOptions& options);
 }
 #endif
\ No newline at end of file
@@ -1,76 +1,124 @@
 #ifndef RESPONSE_STRUCT_H
 #define RESPONSE_STRUCT_H
 
+#include <cstdint>
+#include <string>
+#include <utility>
+
 /**
  * @brief A structure to encapsulate a response with a value and status
  *
- * The `Response` structure is used to store both the result (a value of type T) 
- * and the status (an integer). By default, the status is set to `0` (indicating success),
- * and the value holds the response data. If the status is set to `-1`, it indicates an error 
- * or failure condition. This structure is helpful for functions that may return both 
+ * The `Response` structure is used to store both the result (a value of type T)
+ * and the status (an ErrorCode). By default, the code is `ErrorCode::NONE` (indicating success),
+ * and the value holds the response data. Any other code indicates an error, optionally
+ * detailed by `message`. This structure is helpful for functions that may return both
  * a result and a status code (success or failure).
  *
+ * Responses are move-only: the value is moved (or constructed in place) into the response,
+ * and moved out of it by the caller, so large values such as graphs are never deep-copied.
+ * The message is only filled on errors, so the success path never allocates a string.
+ *
  * @tparam T The type of the value stored in the response
  */
 
-namespace ResponseStatus {
-    const int OK = 0;
-    const int ERROR = -1;
+enum class ErrorCode {
+    NONE = 0,
+    OPEN_FAILED,      // File could not be opened
+    READ_FAILED,      // Stream ended or failed while reading
+    WRITE_FAILED,     // Stream failed while writing
+    INVALID_FORMAT,   // Content does not follow the expected format
+    SIZE_LIMIT,       // Requested size exceeds the allowed limit
+    INVALID_ARGUMENT  // Parameters out of the accepted range
 };
 
+/// @brief Default description of each error code, used when no message was given
+inline const char* errorCodeToString(ErrorCode code) {
+    switch (code) {
+        case ErrorCode::NONE: return "";
+        case ErrorCode::OPEN_FAILED: return "Could not open file";
+        case ErrorCode::READ_FAILED: return "Read failed";
+        case ErrorCode::WRITE_FAILED: return "Write failed";
+        case ErrorCode::INVALID_FORMAT: return "Invalid format";
+        case ErrorCode::SIZE_LIMIT: return "Size limit exceeded";
+        case ErrorCode::INVALID_ARGUMENT: return "Invalid argument";
+    }
+    return "Unknown error";
+}
+
+
 template <typename T>
 struct Response {
-    std::string message = ""; // String empty signals
-     
-    T value; // Must have default initialization. 
-             // Assign value on initialization, otherwise a default copy is created first
-            
+    ErrorCode code = ErrorCode::NONE;
+    std::string message; // Filled only on errors
+
+    T value; // Must have default initialization, used as placeholder on errors
+
+    bool isOk() const { return code == ErrorCode::NONE; }
+
+    /// @brief Error message, or the default description of the code
+    const char* describe() const { return message.empty() ? errorCodeToString(code) : message.c_str(); }
+
+    /// @brief Success, the value is moved in (pass temporaries or std::move)
+    Response(T&& value) : value(std::move(value)) {}
 
-    bool isOk() { return message == ""; }
+    /// @brief Success, the value is built in place from args
+    template <typename... Args>
+    explicit Response(std::in_place_t, Args&&... args) : value(std::forward<Args>(args)...) {}
 
-    Response(std::string message, T value) : message(message), value(value) {}
-    Response(T value) : message(""), value(value) {}
-    
+    /// @brief Error, with an optional detailed message
+    Response(ErrorCode code, std::string message = "") : code(code), message(std::move(message)), value() {}
+
+    Response(const Response&) = delete;
+    Response& operator=(const Response&) = delete;
+    Response(Response&&) = default;
+    Response& operator=(Response&&) = default;
 };
 
 
 template <>
 struct Response<void> {
-    std::string message = ""; // String empty signals there is no error
-            
+    ErrorCode code = ErrorCode::NONE;
+    std::string message; // Filled only on errors
+
 
-    bool isOk() { return message == ""; }
+    bool isOk() const { return code == ErrorCode::NONE; }
 
-    Response(std::string message) : message(message) {}
-    Response() : message("") {}
+    const char* describe() const { return message.empty() ? errorCodeToString(code) : message.c_str(); }
+
+    Response() {}
+    Response(ErrorCode code, std::string message = "") : code(code), message(std::move(message)) {}
 };
 
 
 
 
 
+/**
+ * @brief Response with the duration of the operation that produced it
+ *
+ * I/O operations also fill the bytes moved and the throughput, measured with a finer
+ * clock than `duration` (milliseconds). Same move-only semantics of Response
+ */
 template <typename T>
-struct TimedResponse {
-    std::string error = "";
+struct TimedResponse : Response<T> {
     long duration = 0;
-    T value;
+    uint64_t bytes = 0;
+    double bytesPerSecond = 0;
 
-
-    bool isOk() { return error == ""; }
-    
-    TimedResponse(std::string message, long duration, T value) : error(message), duration(duration), value(value) {}
-    TimedResponse(long duration, T value) : error(""), duration(duration), value(value) {}
+    TimedResponse(long duration, T&& value) : Response<T>(std::move(value)), duration(duration) {}
+    TimedResponse(ErrorCode code, std::string message, long duration)
+        : Response<T>(code, std::move(message)), duration(duration) {}
 };
 
 template <>
-struct TimedResponse<void> {
-    std::string error = "";
+struct TimedResponse<void> : Response<void> {
     long duration = 0;
+    uint64_t bytes = 0;
+    double bytesPerSecond = 0;
 
-    bool isOk() { return error == ""; }
-
-    TimedResponse(std::string message, long duration) : error(message), duration(duration) {}
-    TimedResponse(long duration) : error(""), duration(duration) {}
+    TimedResponse(long duration) : Response<void>(), duration(duration) {}
+    TimedResponse(ErrorCode code, std::string message, long duration)
+        : Response<void>(code, std::move(message)), duration(duration) {}
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,105 @@
+#ifndef RNG_HPP
+#define RNG_HPP
+
+#include <cstdint>
+#include <limits>
+
+
+namespace rng {
+
+    __extension__ typedef unsigned __int128 uint128;
+
+    /// @brief splitmix64 step, used to expand a single seed into a full generator state
+    inline uint64_t splitmix64(uint64_t& state) {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+
+    /**
+     * @brief xoshiro256** generator with jump-ahead
+     *
+     * jump() advances the state by 2^128 steps, so stream k (seed jumped k times) never
+     * overlaps stream k+1 for any practical amount of draws. Work split in fixed blocks
+     * gets one stream per block, which makes the output independent of the thread count.
+     *
+     * Satisfies UniformRandomBitGenerator, so it works with std::shuffle and std distributions,
+     * but the helpers below are used by the generators to keep results equal across
+     * standard library implementations.
+     */
+    class Xoshiro256 {
+      private:
+        uint64_t s[4];
+
+        static uint64_t rotl(uint64_t x, int k) {
+            return (x << k) | (x >> (64 - k));
+        }
+
+      public:
+        using result_type = uint64_t;
+
+        explicit Xoshiro256(uint64_t seed) {
+            uint64_t state = seed;
+            for (int i = 0; i < 4; i++) s[i] = splitmix64(state);
+        }
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<uint64_t>::max(); }
+
+        result_type operator()() {
+            uint64_t result = rotl(s[1] * 5, 7) * 9;
+            uint64_t t = s[1] << 17;
+
+            s[2] ^= s[0];
+            s[3] ^= s[1];
+            s[1] ^= s[2];
+            s[0] ^= s[3];
+            s[2] ^= t;
+            s[3] = rotl(s[3], 45);
+
+            return result;
+        }
+
+        /// @brief Advances 2^128 draws
+        void jump() {
+            static const uint64_t JUMP[] = {
+                0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+            };
+
+            uint64_t t[4] = {0, 0, 0, 0};
+            for (uint64_t jump : JUMP) {
+                for (int b = 0; b < 64; b++) {
+                    if (jump & (1ULL << b)) {
+                        for (int i = 0; i < 4; i++) t[i] ^= s[i];
+                    }
+                    (*this)();
+                }
+            }
+            for (int i = 0; i < 4; i++) s[i] = t[i];
+        }
+
+        /// @brief Uniform integer on [0, bound), Lemire's multiply-shift with rejection
+        uint64_t below(uint64_t bound) {
+            uint128 m = static_cast<uint128>((*this)()) * bound;
+            uint64_t low = static_cast<uint64_t>(m);
+            if (low < bound) {
+                uint64_t threshold = (0 - bound) % bound;
+                while (low < threshold) {
+                    m = static_cast<uint128>((*this)()) * bound;
+                    low = static_cast<uint64_t>(m);
+                }
+            }
+            return static_cast<uint64_t>(m >> 64);
+        }
+
+        /// @brief Uniform double on [0, 1)
+        double uniform() {
+            return static_cast<double>((*this)() >> 11) * 0x1.0p-53;
+        }
+    };
+}
+
+
+#endif  // RNG_HPP
@@ -0,0 +1,245 @@
+#include "scheduler.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+namespace sched {
+
+  // Worker running on this thread, null outside pools
+  thread_local const WorkStealingPool *__currentPool = nullptr;
+  thread_local size_t __currentIndex = 0;
+
+  std::mutex __sharedMutex;
+  std::unique_ptr<WorkStealingPool> __shared;
+  std::atomic<WorkStealingPool*> __sharedPointer{nullptr};
+  unsigned __threadCount = 0;  // 0 until resolved
+  bool __pinThreads = false;
+  bool __sharedCreated = false;
+
+
+  //---- Métodos auxiliares ----//
+
+  unsigned __defaultThreadCount() {
+    const char *env = std::getenv("GRAPH_THREADS");
+    if (env != nullptr) {
+      char *end = nullptr;
+      long value = std::strtol(env, &end, 10);
+      if (end != env && *end == '\0' && value > 0) return static_cast<unsigned>(value);
+    }
+    return std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  void __pinToCpu(size_t index) {
+#ifdef __linux__
+    unsigned cpus = std::max(1u, std::thread::hardware_concurrency());
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(index % cpus, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);  // Best effort, cgroups may forbid it
+#else
+    (void) index;
+#endif
+  }
+
+  /// @brief Drops the shared pool, the next sharedPool() builds it with the current settings
+  void __resetShared() {
+    std::unique_ptr<WorkStealingPool> old;
+    {
+      std::lock_guard<std::mutex> lock(__sharedMutex);
+      old = std::move(__shared);
+      __sharedPointer.store(nullptr, std::memory_order_release);
+      __sharedCreated = false;
+    }
+    // Destroyed outside the lock, it waits for its tasks
+  }
+
+
+  //---- WorkStealingPool ----//
+
+  bool WorkStealingPool::take(int self, Task& task) {
+    if (self >= 0) {
+      Worker& own = *workers[self];
+      std::lock_guard<std::mutex> lock(own.mutex);
+      if (!own.tasks.empty()) {
+        task = std::move(own.tasks.back());
+        own.tasks.pop_back();
+        return true;
+      }
+    }
+
+    size_t first = self >= 0 ? static_cast<size_t>(self) : 0;
+    for (size_t offset = self >= 0 ? 1 : 0; offset < workers.size(); offset++) {
+      Worker& victim = *workers[(first + offset) % workers.size()];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (!victim.tasks.empty()) {
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        stolen.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void WorkStealingPool::execute(Task& task) {
+    queued.fetch_sub(1, std::memory_order_acq_rel);
+    task();
+    task = nullptr;
+
+    if (unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      std::lock_guard<std::mutex> lock(sleepMutex);
+      idle.notify_all();
+    }
+  }
+
+  void WorkStealingPool::loop(size_t self, bool pin) {
+    __currentPool = this;
+    __currentIndex = self;
+    if (pin) __pinToCpu(self);
+
+    Task task;
+    while (true) {
+      if (take(static_cast<int>(self), task)) {
+        execute(task);
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(sleepMutex);
+      wake.wait(lock, [&]() { return stopping || queued.load(std::memory_order_acquire) > 0; });
+      if (stopping && queued.load(std::memory_order_acquire) == 0) return;
+    }
+  }
+
+  WorkStealingPool::WorkStealingPool(unsigned threadQuantity, bool pinThreads) {
+    if (threadQuantity == 0) threadQuantity = std::max(1u, std::thread::hardware_concurrency());
+
+    for (unsigned i = 0; i < threadQuantity; i++) workers.push_back(std::make_unique<Worker>());
+    for (unsigned i = 0; i < threadQuantity; i++) threads.emplace_back([this, i, pinThreads]() { loop(i, pinThreads); });
+  }
+
+  WorkStealingPool::~WorkStealingPool() {
+    wait();
+    {
+      std::lock_guard<std::mutex> lock(sleepMutex);
+      stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads) thread.join();
+  }
+
+  void WorkStealingPool::submit(Task task) {
+    int self = currentWorker();
+    size_t target = self >= 0 ? static_cast<size_t>(self)
+                              : nextWorker.fetch_add(1, std::memory_order_relaxed) % workers.size();
+
+    // Counted before the push, so a worker that takes it right away never sees the counter underflow
+    unfinished.fetch_add(1, std::memory_order_acq_rel);
+    queued.fetch_add(1, std::memory_order_acq_rel);
+    {
+      Worker& worker = *workers[target];
+      std::lock_guard<std::mutex> lock(worker.mutex);
+      worker.tasks.push_back(std::move(task));
+    }
+
+    // Taking the lock orders the increment before the predicate check of a sleeping worker
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    wake.notify_one();
+  }
+
+  bool WorkStealingPool::runPending() {
+    Task task;
+    if (!take(currentWorker(), task)) return false;
+    execute(task);
+    return true;
+  }
+
+  void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    idle.wait(lock, [&]() { return unfinished.load(std::memory_order_acquire) == 0; });
+  }
+
+  int WorkStealingPool::currentWorker() const {
+    return __currentPool == this ? static_cast<int>(__currentIndex) : -1;
+  }
+
+
+  //---- Pool compartilhado ----//
+
+  void setThreadCount(unsigned threads) {
+    {
+      std::lock_guard<std::mutex> lock(__sharedMutex);
+      __threadCount = threads;
+    }
+    __resetShared();
+  }
+
+  unsigned threadCount() {
+    std::lock_guard<std::mutex> lock(__sharedMutex);
+    if (__threadCount == 0) __threadCount = __defaultThreadCount();
+    return __threadCount;
+  }
+
+  void setAffinity(bool pinThreads) {
+    {
+      std::lock_guard<std::mutex> lock(__sharedMutex);
+      __pinThreads = pinThreads;
+    }
+    __resetShared();
+  }
+
+  WorkStealingPool* sharedPool() {
+    WorkStealingPool *pool = __sharedPointer.load(std::memory_order_acquire);
+    if (pool != nullptr) return pool;
+
+    std::lock_guard<std::mutex> lock(__sharedMutex);
+    if (!__sharedCreated) {
+      if (__threadCount == 0) __threadCount = __defaultThreadCount();
+      // The waiting caller is one of the threads
+      if (__threadCount > 1) __shared = std::make_unique<WorkStealingPool>(__threadCount - 1, __pinThreads);
+      __sharedPointer.store(__shared.get(), std::memory_order_release);
+      __sharedCreated = true;
+    }
+    return __shared.get();
+  }
+
+  int workerIndex() {
+    WorkStealingPool *pool = __sharedPointer.load(std::memory_order_acquire);
+    return pool != nullptr ? pool->currentWorker() + 1 : 0;
+  }
+
+
+  //---- TaskGroup ----//
+
+  void TaskGroup::run(WorkStealingPool::Task task) {
+    if (pool == nullptr) {
+      task();
+      return;
+    }
+
+    pending.fetch_add(1, std::memory_order_acq_rel);
+    pool->submit([this, task = std::move(task)]() {
+      task();
+      // Under the lock, so wait() cannot return (and the group go away) while it is held
+      std::lock_guard<std::mutex> lock(mutex);
+      if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) done.notify_all();
+    });
+  }
+
+  void TaskGroup::wait() {
+    if (pool == nullptr) return;
+    while (pending.load(std::memory_order_acquire) > 0) {
+      if (pool->runPending()) continue;
+
+      // Everything left is running elsewhere
+      std::unique_lock<std::mutex> lock(mutex);
+      done.wait_for(lock, std::chrono::microseconds(200), [&]() { return pending.load(std::memory_order_acquire) == 0; });
+    }
+    std::lock_guard<std::mutex> lock(mutex);  // The last task may still be releasing it
+  }
+}
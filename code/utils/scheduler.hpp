@@ -0,0 +1,185 @@
+#ifndef SCHEDULER_HPP
+#define SCHEDULER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/**
+ * @brief Project-wide work-stealing scheduler
+ *
+ * Every worker owns a deque: it pushes and pops its own tasks at the back (LIFO, the
+ * most recent task is the one with warm caches) and, when it runs dry, steals from the
+ * front of the others (FIFO, the oldest and usually largest pieces of work). Tasks
+ * submitted from outside the pool are spread over the deques round-robin, tasks
+ * submitted from a worker stay on its own deque.
+ *
+ * Parallel code (CSR builds, canonicalize, the generators, the naive bridge search,
+ * batches...) submits to one shared pool, sized by a single knob: setThreadCount(), or
+ * the GRAPH_THREADS environment variable, or the hardware thread count. The thread that
+ * waits on a TaskGroup runs pending tasks meanwhile, so it counts as one of those threads
+ * and the shared pool starts threadCount() - 1 workers.
+ *
+ * Idle workers sleep on a condition variable, so an empty pool costs nothing.
+ */
+namespace sched {
+
+    class WorkStealingPool {
+      public:
+        using Task = std::function<void()>;
+
+      private:
+        struct Worker {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        std::vector<std::thread> threads;
+
+        std::atomic<size_t> queued{0};      // Submitted and not yet taken
+        std::atomic<size_t> unfinished{0};  // Submitted and not yet finished
+        std::atomic<size_t> nextWorker{0};  // Round-robin of external submissions
+        std::atomic<size_t> stolen{0};
+        bool stopping = false;
+
+        std::mutex sleepMutex;
+        std::condition_variable wake;
+        std::condition_variable idle;
+
+        /// @brief Own deque first (self = -1 on outside threads), then the others
+        bool take(int self, Task& task);
+        void execute(Task& task);
+        void loop(size_t self, bool pin);
+
+      public:
+        /**
+         * @brief Starts `threads` workers, 0 uses std::thread::hardware_concurrency()
+         * @param pinThreads Binds worker i to CPU i (Linux only, ignored elsewhere)
+         */
+        explicit WorkStealingPool(unsigned threads = 0, bool pinThreads = false);
+
+        /// @brief Runs the remaining tasks, then joins the workers
+        ~WorkStealingPool();
+
+        WorkStealingPool(const WorkStealingPool&) = delete;
+        WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+        void submit(Task task);
+
+        /// @brief Runs one queued task on the calling thread. False when there was none
+        bool runPending();
+
+        /// @brief Waits until every submitted task (and the tasks they submitted) finished
+        void wait();
+
+        unsigned size() const { return static_cast<unsigned>(workers.size()); }
+
+        /// @brief Tasks taken from another worker's deque so far
+        size_t stealCount() const { return stolen.load(std::memory_order_relaxed); }
+
+        /// @brief Index of the calling worker of this pool, -1 on other threads
+        int currentWorker() const;
+    };
+
+
+    //---- Pool compartilhado ----//
+
+    /**
+     * @brief Total threads of parallel work, callers included. 0 restores the default
+     *
+     * Replaces the shared pool, so call it while no parallel work is running.
+     */
+    void setThreadCount(unsigned threads);
+
+    /// @brief GRAPH_THREADS, or std::thread::hardware_concurrency() when unset
+    unsigned threadCount();
+
+    /// @brief Pins the workers of the shared pool to CPUs. Replaces the pool, like setThreadCount
+    void setAffinity(bool pinThreads);
+
+    /// @brief Shared pool, created on first use. Null when threadCount() is 1
+    WorkStealingPool* sharedPool();
+
+    /// @brief 1 + index of the calling worker of the shared pool, 0 on other threads
+    int workerIndex();
+
+
+    /**
+     * @brief Fork/join: tasks run on the shared pool, wait() joins them
+     *
+     * While waiting, the caller runs pending tasks (its own subtasks first when it is a
+     * worker), so nested groups never leave a thread blocked with work queued. Without a
+     * shared pool, run() executes the task right away.
+     */
+    class TaskGroup {
+      private:
+        WorkStealingPool *pool;
+        std::atomic<size_t> pending{0};
+        std::mutex mutex;
+        std::condition_variable done;
+
+      public:
+        TaskGroup() : pool(sharedPool()) {}
+        ~TaskGroup() { wait(); }
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        void run(WorkStealingPool::Task task);
+        void wait();
+    };
+
+
+    template <typename F>
+    void __splitFor(TaskGroup& group, size_t begin, size_t end, size_t grain, const F& fn) {
+        // Halves go to the deque, thieves take the largest ones first
+        while (end - begin > grain) {
+            size_t middle = begin + (end - begin) / 2;
+            group.run([&group, middle, end, grain, &fn]() { __splitFor(group, middle, end, grain, fn); });
+            end = middle;
+        }
+        fn(begin, end);
+    }
+
+    /**
+     * @brief Calls fn(first, last) over sub-ranges of [begin, end) with at most `grain` items
+     *
+     * Ranges are split in halves on demand, so idle workers steal big pieces first and
+     * the calls stay coarse when everyone is busy. Runs fn(begin, end) inline when the
+     * range fits on one grain or there is no shared pool.
+     */
+    template <typename F>
+    void parallelFor(size_t begin, size_t end, size_t grain, const F& fn) {
+        if (begin >= end) return;
+        grain = std::max<size_t>(grain, 1);
+        if (end - begin <= grain || sharedPool() == nullptr) {
+            fn(begin, end);
+            return;
+        }
+
+        TaskGroup group;
+        __splitFor(group, begin, end, grain, fn);
+        group.wait();
+    }
+
+    /// @brief Calls fn(i) for i on [0, count) on separate tasks, for loops that claim their own work
+    template <typename F>
+    void parallelInvoke(unsigned count, const F& fn) {
+        TaskGroup group;
+        for (unsigned i = 1; i < count; i++) group.run([i, &fn]() { fn(i); });
+        if (count > 0) fn(0u);
+        group.wait();
+    }
+}
+
+
+#endif  // SCHEDULER_HPP
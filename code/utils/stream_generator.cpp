@@ -0,0 +1,373 @@
+#include "stream_generator.hpp"
+#include "response_struct.hpp"
+#include "rng.hpp"
+#include "scheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace randomgraph {
+
+  // Vertices per block, tiles are the pairs between two blocks
+  const int STREAM_BLOCK = 1 << 16;
+
+  // Write buffer of each partition
+  const size_t STREAM_BUFFER = 1 << 20;
+
+
+  struct __StreamPlan {
+    int n;
+    int blocks;
+    double p;       // Chance of every pair at distance >= 2
+    uint64_t seed;
+
+    int blockBegin(int b) const { return static_cast<int>(static_cast<long long>(b) * STREAM_BLOCK); }
+    int blockEnd(int b) const { return static_cast<int>(std::min<long long>(n, static_cast<long long>(b + 1) * STREAM_BLOCK)); }
+  };
+
+
+  /**
+   * @brief Emits every random pair (i, j), i in block x, j in block y, x <= y, j - i >= 2
+   *
+   * Each tile reads its own stream, keyed by (x, y), so any partition regenerates the same pairs.
+   */
+  template <typename Emit>
+  void __sampleTile(const __StreamPlan& plan, int x, int y, Emit&& emit) {
+    if (plan.p <= 0.0) return;
+
+    uint64_t key = static_cast<uint64_t>(x) * plan.blocks + y;
+    rng::Xoshiro256 random(plan.seed ^ rng::splitmix64(key));
+
+    const bool full = plan.p >= 1.0;
+    const double logq = full ? 0.0 : std::log1p(-plan.p);
+    auto skip = [&]() -> double {
+      return full ? 0.0 : std::floor(std::log1p(-random.uniform()) / logq);
+    };
+
+    long long rowBegin = plan.blockBegin(x);
+    long long rows = plan.blockEnd(x) - rowBegin;
+
+    if (x != y) {
+      // Rectangle, only (last of x, first of y) can be a path edge
+      long long colBegin = plan.blockBegin(y);
+      long long cols = plan.blockEnd(y) - colBegin;
+      long long total = rows * cols;
+
+      long long position = -1;
+      while (true) {
+        double gap = skip();
+        if (gap >= static_cast<double>(total)) break;
+        position += 1 + static_cast<long long>(gap);
+        if (position >= total) break;
+
+        long long i = rowBegin + position / cols;
+        long long j = colBegin + position % cols;
+        if (j - i >= 2) emit(static_cast<int>(i), static_cast<int>(j));
+      }
+      return;
+    }
+
+    // Triangle, row j holds i = 0 ... j - 2
+    double total = static_cast<double>(rows) * static_cast<double>(rows) / 2.0;
+    long long j = 2, i = -1;
+    while (j < rows) {
+      double gap = skip();
+      if (gap >= total) break;
+      i += 1 + static_cast<long long>(gap);
+      while (j < rows && i > j - 2) {
+        i -= j - 1;
+        j++;
+      }
+      if (j < rows) emit(static_cast<int>(rowBegin + i), static_cast<int>(rowBegin + j));
+    }
+  }
+
+  /// @brief Emits every random pair with an endpoint on blocks [first, last)
+  template <typename Emit>
+  void __samplePartition(const __StreamPlan& plan, int first, int last, Emit&& emit) {
+    for (int x = 0; x < plan.blocks; x++) {
+      int y = x < first ? first : x;
+      int yEnd = x < first ? last : plan.blocks;
+      if (x >= last) break;
+      for (; y < yEnd; y++) __sampleTile(plan, x, y, emit);
+    }
+  }
+
+
+  /// @brief Odd vertex bitset with rank/select by per-word prefix counts
+  struct __ParityIndex {
+    std::vector<uint64_t> bits;
+    std::vector<uint64_t> before;  // Odd vertices before each word
+
+    bool isOdd(int v) const { return (bits[v >> 6] >> (v & 63)) & 1; }
+
+    uint64_t count() const { return before.back(); }
+
+    void buildRank() {
+      before.assign(bits.size() + 1, 0);
+      for (size_t w = 0; w < bits.size(); w++) {
+        before[w + 1] = before[w] + __builtin_popcountll(bits[w]);
+      }
+    }
+
+    uint64_t rank(int v) const {
+      uint64_t word = bits[v >> 6] & ((uint64_t(1) << (v & 63)) - 1);
+      return before[v >> 6] + __builtin_popcountll(word);
+    }
+
+    int select(uint64_t k) const {
+      size_t w = std::upper_bound(before.begin(), before.end(), k) - before.begin() - 1;
+      uint64_t word = bits[w];
+      for (uint64_t skipped = k - before[w]; skipped > 0; skipped--) {
+        word &= word - 1;
+      }
+      return static_cast<int>(w * 64 + __builtin_ctzll(word));
+    }
+
+    /// @brief Vertex paired with the odd vertex v
+    int partner(int v) const {
+      uint64_t half = count() / 2;
+      uint64_t k = rank(v);
+      return select(k < half ? k + half : k - half);
+    }
+  };
+
+
+  /// @brief Sorted neighbours of v, regenerating the tiles of its block
+  std::vector<int> __neighboursOf(const __StreamPlan& plan, int v) {
+    std::vector<int> neighbours;
+    if (v > 0) neighbours.push_back(v - 1);
+    if (v + 1 < plan.n) neighbours.push_back(v + 1);
+
+    int block = v / STREAM_BLOCK;
+    __samplePartition(plan, block, block + 1, [&](int i, int j) {
+      if (i == v) neighbours.push_back(j);
+      else if (j == v) neighbours.push_back(i);
+    });
+
+    std::sort(neighbours.begin(), neighbours.end());
+    return neighbours;
+  }
+
+
+  Response<StreamResult> streamGraphToFile(const std::string& filename, int n, long long edges, const StreamOptions& options) {
+    if (n < 1) return Response<StreamResult>(ErrorCode::INVALID_ARGUMENT, "Vertex quantity must be positive");
+
+    __StreamPlan plan;
+    plan.n = n;
+    plan.blocks = static_cast<int>((static_cast<long long>(n) + STREAM_BLOCK - 1) / STREAM_BLOCK);
+    plan.seed = options.seed;
+
+    double gapPairs = static_cast<double>(n - 1) * static_cast<double>(n - 2) / 2.0;
+    double extraEdges = static_cast<double>(edges) - (n - 1);
+    plan.p = (gapPairs > 0 && extraEdges > 0) ? std::min(1.0, extraEdges / gapPairs) : 0.0;
+
+    unsigned threads = options.threads != 0 ? options.threads : sched::threadCount();
+    threads = std::max(1u, threads);
+
+    // Pairs (8 bytes) and lists (4 bytes) per half-edge, offsets per vertex
+    double expectedDegree = 2.0 + plan.p * std::max(n - 3, 0);
+    double blockBytes = STREAM_BLOCK * (8.0 + 12.0 * expectedDegree * 1.1);
+    double partitionBytes = static_cast<double>(options.memoryBudget) / threads;
+    int blocksPerPartition = static_cast<int>(std::max(1.0, std::floor(partitionBytes / blockBytes)));
+    int partitions = (plan.blocks + blocksPerPartition - 1) / blocksPerPartition;
+    threads = std::min<unsigned>(threads, partitions);
+
+    {
+      std::ofstream header(filename, std::ios::binary | std::ios::trunc);
+      if (!header) return Response<StreamResult>(ErrorCode::OPEN_FAILED, "Error: Could not open output file for writing");
+      header.write(reinterpret_cast<const char*>(&n), sizeof(n));
+      if (!header) return Response<StreamResult>(ErrorCode::WRITE_FAILED, "Error: Could not write output file header");
+    }
+
+
+    //---- Paridade ----//
+
+    __ParityIndex parity;
+    int specialA = -1, specialB = -1, specialC = -1;  // Path a - c - b replacing the toggle of (a, b)
+
+    if (options.eulerian) {
+      parity.bits.assign((static_cast<size_t>(n) + 63) / 64, 0);
+
+      // Blocks are multiples of 64 vertices, so each partition owns whole words
+      std::atomic<int> nextPartition(0);
+      auto countParity = [&]() {
+        std::vector<uint8_t> odd;
+        for (int part = nextPartition++; part < partitions; part = nextPartition++) {
+          int first = part * blocksPerPartition;
+          int last = std::min(plan.blocks, first + blocksPerPartition);
+          int lo = plan.blockBegin(first), hi = plan.blockEnd(last - 1);
+
+          odd.assign(hi - lo, 0);
+          for (int v = lo; v < hi; v++) odd[v - lo] = (v > 0) ^ (v + 1 < n);
+          __samplePartition(plan, first, last, [&](int i, int j) {
+            if (i >= lo && i < hi) odd[i - lo] ^= 1;
+            if (j >= lo && j < hi) odd[j - lo] ^= 1;
+          });
+
+          for (int v = lo; v < hi; v++) {
+            if (odd[v - lo]) parity.bits[v >> 6] |= uint64_t(1) << (v & 63);
+          }
+        }
+      };
+
+      sched::parallelInvoke(threads, [&](unsigned) { countParity(); });
+
+      parity.buildRank();
+
+      // Pairs are k and k + K/2, so only K = 2 can pair the two ends of a path edge
+      if (parity.count() == 2 && parity.select(1) == parity.select(0) + 1) {
+        int a = parity.select(0), b = parity.select(1);
+        std::vector<int> used = __neighboursOf(plan, a);
+        std::vector<int> usedB = __neighboursOf(plan, b);
+        used.insert(used.end(), usedB.begin(), usedB.end());
+        used.push_back(a);
+        used.push_back(b);
+        std::sort(used.begin(), used.end());
+
+        for (int c = 0; c < n; c++) {
+          if (!std::binary_search(used.begin(), used.end(), c)) {
+            specialA = a;
+            specialB = b;
+            specialC = c;
+            break;
+          }
+        }
+
+        // No free vertex (n <= 3 or complete graph), the two odd vertices are kept
+        if (specialC == -1) {
+          std::fill(parity.bits.begin(), parity.bits.end(), 0);
+          parity.buildRank();
+        }
+      }
+    }
+
+
+    //---- Escrita ----//
+
+    std::vector<uint64_t> fileOffset(partitions + 1, 0);
+    std::vector<char> offsetReady(partitions + 1, 0);
+    fileOffset[0] = sizeof(int);
+    offsetReady[0] = 1;
+    std::mutex offsetMutex;
+    std::condition_variable offsetChanged;
+
+    std::atomic<long long> halfEdgesWritten(0);
+    std::mutex errorMutex;
+    ErrorCode errorCode = ErrorCode::NONE;
+    std::string errorMessage;
+
+    std::atomic<int> nextPartition(0);
+    auto writePartitions = [&]() {
+      std::vector<std::pair<int, int>> halfEdges;
+      std::vector<uint64_t> offsets;
+      std::vector<int> lists, row;
+      std::vector<char> ioBuffer(STREAM_BUFFER);
+
+      std::fstream out(filename, std::ios::in | std::ios::out | std::ios::binary);
+      out.rdbuf()->pubsetbuf(ioBuffer.data(), ioBuffer.size());
+
+      for (int part = nextPartition++; part < partitions; part = nextPartition++) {
+        int first = part * blocksPerPartition;
+        int last = std::min(plan.blocks, first + blocksPerPartition);
+        int lo = plan.blockBegin(first), hi = plan.blockEnd(last - 1);
+        int size = hi - lo;
+
+        halfEdges.clear();
+        for (int v = lo; v < hi; v++) {
+          if (v > 0) halfEdges.emplace_back(v - lo, v - 1);
+          if (v + 1 < n) halfEdges.emplace_back(v - lo, v + 1);
+        }
+        __samplePartition(plan, first, last, [&](int i, int j) {
+          if (i >= lo && i < hi) halfEdges.emplace_back(i - lo, j);
+          if (j >= lo && j < hi) halfEdges.emplace_back(j - lo, i);
+        });
+
+        // Counting sort by local vertex
+        offsets.assign(size + 1, 0);
+        for (const auto& half : halfEdges) offsets[half.first + 1]++;
+        for (int v = 0; v < size; v++) offsets[v + 1] += offsets[v];
+        lists.resize(halfEdges.size());
+        {
+          std::vector<uint64_t> cursor(offsets.begin(), offsets.end() - 1);
+          for (const auto& half : halfEdges) lists[cursor[half.first]++] = half.second;
+        }
+        std::vector<std::pair<int, int>>().swap(halfEdges);
+        for (int v = 0; v < size; v++) {
+          std::sort(lists.begin() + offsets[v], lists.begin() + offsets[v + 1]);
+        }
+
+        // Sorted list of v after the parity fix
+        auto fixedRow = [&](int v) {
+          auto begin = lists.begin() + offsets[v - lo], end = lists.begin() + offsets[v - lo + 1];
+          row.assign(begin, end);
+
+          if (v == specialA || v == specialB) {
+            row.insert(std::lower_bound(row.begin(), row.end(), specialC), specialC);
+          } else if (options.eulerian && parity.isOdd(v)) {
+            int partner = parity.partner(v);
+            auto found = std::lower_bound(row.begin(), row.end(), partner);
+            if (found != row.end() && *found == partner) row.erase(found);
+            else row.insert(found, partner);
+          }
+
+          if (v == specialC) {
+            for (int extra : {specialA, specialB}) {
+              row.insert(std::lower_bound(row.begin(), row.end(), extra), extra);
+            }
+          }
+        };
+
+        uint64_t partitionHalfEdges = 0;
+        for (int v = lo; v < hi; v++) {
+          fixedRow(v);
+          partitionHalfEdges += row.size();
+        }
+        uint64_t bytes = sizeof(int) * (static_cast<uint64_t>(size) + partitionHalfEdges);
+
+        uint64_t offset;
+        {
+          std::unique_lock<std::mutex> lock(offsetMutex);
+          offsetChanged.wait(lock, [&]() { return offsetReady[part] != 0; });
+          offset = fileOffset[part];
+          fileOffset[part + 1] = offset + bytes;
+          offsetReady[part + 1] = 1;
+        }
+        offsetChanged.notify_all();
+
+        if (!out) continue;  // Offsets still advance so that no partition waits forever
+        out.seekp(static_cast<std::streamoff>(offset));
+        for (int v = lo; v < hi; v++) {
+          fixedRow(v);
+          int length = static_cast<int>(row.size());
+          out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+          out.write(reinterpret_cast<const char*>(row.data()), sizeof(int) * length);
+        }
+        halfEdgesWritten += partitionHalfEdges;
+      }
+
+      out.flush();
+      if (!out) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        errorCode = ErrorCode::WRITE_FAILED;
+        errorMessage = "Error: Could not write partition to output file";
+      }
+    };
+
+    sched::parallelInvoke(threads, [&](unsigned) { writePartitions(); });
+
+    if (errorCode != ErrorCode::NONE) return Response<StreamResult>(errorCode, errorMessage);
+
+    StreamResult result;
+    result.edges = halfEdgesWritten / 2;
+    result.partitions = partitions;
+    result.bytes = fileOffset[partitions];
+    return Response<StreamResult>(std::move(result));
+  }
+}
@@ -0,0 +1,59 @@
+#ifndef STREAM_GENERATOR_HPP
+#define STREAM_GENERATOR_HPP
+
+#include "response_struct.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+
+namespace randomgraph {
+
+    /**
+     * @brief Settings of streamGraphToFile
+     *
+     * The graph only depends on the seed, n and the edge target. Threads and memory budget
+     * change how it is produced, never what is produced.
+     */
+    struct StreamOptions {
+        uint64_t seed = 0;
+        unsigned threads = 0;                  // Partition tasks in flight, 0 uses sched::threadCount()
+        size_t memoryBudget = size_t(1) << 28; // Bytes shared by the partitions in flight (256MB)
+        bool eulerian = false;                 // Fixes parity so that every degree is even
+    };
+
+    struct StreamResult {
+        long long edges = 0;     // Edges written
+        int partitions = 0;      // Vertex ranges the work was split in
+        uint64_t bytes = 0;      // Size of the written file
+    };
+
+    /**
+     * @brief Generates a graph straight into a .graph file, without building it in memory
+     *
+     * Same shape as bruteForceCreateConnected: path 0-1-...-(n-1) for connectivity plus
+     * every pair at distance >= 2 with the probability that gives `edges` on average.
+     *
+     * Vertices are split in blocks of 2^16, and the random pairs between blocks x <= y
+     * form a tile sampled by geometric skipping from its own keyed stream. A partition
+     * (a range of blocks sized by the memory budget) regenerates every tile touching it,
+     * so the neighbour lists of its vertices can be built and written without any other
+     * partition in memory. Partitions run in parallel and are written in place at their
+     * final file offset.
+     *
+     * With `eulerian`, a first counting pass marks odd vertices on a bitset. The k-th odd
+     * vertex is paired with the (k + K/2)-th one (rank/select over the bitset) and the edge
+     * between them is toggled, which keeps the path and makes every degree even.
+     * Besides the budget, the bitset and its rank table take n/4 bytes.
+     *
+     * @param filename Output file, on the graphformat layout
+     * @param n Vertex quantity
+     * @param edges Expected edge quantity, the result may differ by a few standard deviations
+     * @param options Seed, threads, memory budget and Eulerian settings
+     */
+    Response<StreamResult> streamGraphToFile(const std::string& filename, int n, long long edges, const StreamOptions& options);
+}
+
+
+#endif  // STREAM_GENERATOR_HPP
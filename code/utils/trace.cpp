@@ -0,0 +1,158 @@
+#include "trace.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace tracing {
+
+  std::atomic<bool> __active{false};
+
+  struct __Event {
+    const char *name;
+    uint64_t begin;
+    uint64_t end;
+  };
+
+  // Ring of one thread, only that thread writes to it
+  struct __ThreadBuffer {
+    int tid = 0;
+    std::string threadName;
+    std::vector<__Event> events;
+    std::atomic<uint64_t> written{0};
+    uint64_t generation = 0;  // start() that created it, older rings are ignored
+  };
+
+  std::mutex __registryMutex;
+  std::vector<std::shared_ptr<__ThreadBuffer>> __registry;  // Kept alive after their threads exit
+  std::atomic<int64_t> __epoch{0};  // steady_clock nanoseconds of the last start()
+  size_t __capacity = size_t(1) << 18;
+  std::atomic<uint64_t> __generation{1};
+  int __nextTid = 1;
+
+  thread_local std::shared_ptr<__ThreadBuffer> __local;
+
+
+  //---- Métodos auxiliares ----//
+
+  __ThreadBuffer& __buffer() {
+    std::lock_guard<std::mutex> lock(__registryMutex);
+    if (!__local || __local->generation != __generation.load(std::memory_order_relaxed)) {
+      std::string name = __local ? __local->threadName : std::string();
+
+      __local = std::make_shared<__ThreadBuffer>();
+      __local->tid = __nextTid++;
+      __local->threadName = name.empty() ? "thread " + std::to_string(__local->tid) : name;
+      __local->events.resize(__capacity);
+      __local->generation = __generation.load(std::memory_order_relaxed);
+      __registry.push_back(__local);
+    }
+    return *__local;
+  }
+
+  // The ring is checked on every record, the lock is only taken when it must be (re)created
+  __ThreadBuffer& __currentBuffer() {
+    if (__local && __local->generation == __generation.load(std::memory_order_acquire)) return *__local;
+    return __buffer();
+  }
+
+  std::string __jsonEscape(const std::string& text) {
+    const char *hex = "0123456789abcdef";
+    std::string escaped;
+    for (char c : text) {
+      unsigned char byte = static_cast<unsigned char>(c);
+      if (c == '"' || c == '\\') {
+        escaped += '\\';
+        escaped += c;
+      } else if (byte < 0x20) {
+        // Raw control characters are not allowed inside JSON strings
+        escaped += "\\u00";
+        escaped += hex[byte >> 4];
+        escaped += hex[byte & 0xf];
+      } else {
+        escaped += c;
+      }
+    }
+    return escaped;
+  }
+
+
+  //---- Métodos públicos ----//
+
+  void start(size_t eventsPerThread) {
+    std::lock_guard<std::mutex> lock(__registryMutex);
+    __registry.clear();
+    __capacity = eventsPerThread > 0 ? eventsPerThread : 1;
+    __generation.fetch_add(1, std::memory_order_release);
+    __epoch.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count(), std::memory_order_relaxed);
+    __active.store(true, std::memory_order_release);
+  }
+
+  void stop() {
+    __active.store(false, std::memory_order_release);
+  }
+
+  void setThreadName(const std::string& name) {
+    std::lock_guard<std::mutex> lock(__registryMutex);
+    if (!__local || __local->generation != __generation.load(std::memory_order_relaxed)) {
+      // Remembered until the ring is created on the first span
+      __local = std::make_shared<__ThreadBuffer>();
+      __local->generation = 0;
+    }
+    __local->threadName = name;
+  }
+
+  uint64_t now() {
+    int64_t current = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+    return static_cast<uint64_t>(current - __epoch.load(std::memory_order_relaxed));
+  }
+
+  void record(const char *name, uint64_t begin, uint64_t end) {
+    __ThreadBuffer& buffer = __currentBuffer();
+    uint64_t position = buffer.written.load(std::memory_order_relaxed);
+    buffer.events[position % buffer.events.size()] = {name, begin, end};
+    buffer.written.store(position + 1, std::memory_order_release);
+  }
+
+  Response<void> writeChromeTrace(const std::string& filename) {
+    std::ofstream out(filename, std::ios::trunc);
+    if (!out) return Response<void>(ErrorCode::OPEN_FAILED, "Error: Could not open trace file for writing");
+
+    std::lock_guard<std::mutex> lock(__registryMutex);
+    uint64_t dropped = 0;
+    bool first = true;
+    auto separator = [&]() -> std::ostream& {
+      out << (first ? "\n  " : ",\n  ");
+      first = false;
+      return out;
+    };
+
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    for (const std::shared_ptr<__ThreadBuffer>& buffer : __registry) {
+      separator() << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << buffer->tid
+                  << ", \"args\": {\"name\": \"" << __jsonEscape(buffer->threadName) << "\"}}";
+
+      uint64_t written = buffer->written.load(std::memory_order_acquire);
+      uint64_t capacity = buffer->events.size();
+      uint64_t oldest = written > capacity ? written - capacity : 0;
+      dropped += oldest;
+
+      for (uint64_t i = oldest; i < written; i++) {
+        const __Event& event = buffer->events[i % capacity];
+        separator() << "{\"name\": \"" << __jsonEscape(event.name) << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << buffer->tid
+                    << ", \"ts\": " << event.begin / 1000.0 << ", \"dur\": " << (event.end - event.begin) / 1000.0 << "}";
+      }
+    }
+    out << "\n], \"otherData\": {\"droppedEvents\": " << dropped << "}}" << std::endl;
+
+    out.close();
+    if (!out) return Response<void>(ErrorCode::WRITE_FAILED, "Error: Could not write trace file");
+    return Response<void>();
+  }
+}
@@ -0,0 +1,82 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "response_struct.hpp"
+
+
+/**
+ * @brief Scoped spans written as a Chrome trace (chrome://tracing, ui.perfetto.dev)
+ *
+ * Every thread records its spans on its own ring buffer, so recording never locks. When
+ * a buffer is full the oldest spans are overwritten and counted as dropped.
+ *
+ * While tracing is stopped a Span costs a relaxed load and a branch, so spans can stay
+ * on hot library functions (tarjan, executeNaive, Fleury steps...).
+ *
+ * Span names must outlive the trace, use string literals.
+ */
+namespace tracing {
+
+    extern std::atomic<bool> __active;
+
+    inline bool enabled() {
+        return __active.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Clears previous spans and starts recording, `eventsPerThread` sizes the rings created from now on
+    void start(size_t eventsPerThread = size_t(1) << 18);
+
+    /// @brief Stops recording, recorded spans are kept until the next start()
+    void stop();
+
+    /// @brief Name of the calling thread on the timeline
+    void setThreadName(const std::string& name);
+
+    /// @brief Nanoseconds since start()
+    uint64_t now();
+
+    /// @brief Appends a finished span to the ring of the calling thread
+    void record(const char *name, uint64_t begin, uint64_t end);
+
+    /**
+     * @brief Writes every recorded span as Chrome trace JSON ("X" events, microseconds)
+     *
+     * Call it after stop(), once the traced threads are done.
+     */
+    Response<void> writeChromeTrace(const std::string& filename);
+
+
+    class Span {
+      private:
+        const char *name = nullptr;  // Null when tracing was off at construction
+        uint64_t begin = 0;
+
+      public:
+        explicit Span(const char *label) {
+            if (enabled()) {
+                name = label;
+                begin = now();
+            }
+        }
+        ~Span() {
+            if (name != nullptr) record(name, begin, now());
+        }
+
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+    };
+}
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+/// @brief Span from this line to the end of the enclosing scope
+#define TRACE_SPAN(name) tracing::Span TRACE_CONCAT(__traceSpan, __LINE__)(name)
+
+
+#endif  // TRACE_HPP
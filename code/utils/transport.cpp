@@ -0,0 +1,300 @@
+#include "transport.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+namespace transport {
+
+  namespace {
+
+    // Frames above this are taken as a broken stream, not as a message to allocate
+    const uint64_t MAX_FRAME = uint64_t(1) << 36;
+
+
+    //---- THREADS ----//
+
+    /// @brief One direction of a channel. Closed once the sending side is gone
+    class Mailbox {
+      private:
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::deque<Message> messages;
+        bool closed = false;
+
+      public:
+        void push(Message message) {
+          {
+            std::lock_guard<std::mutex> lock(mutex);
+            messages.push_back(std::move(message));
+          }
+          ready.notify_one();
+        }
+
+        Response<Message> pop() {
+          std::unique_lock<std::mutex> lock(mutex);
+          ready.wait(lock, [&]() { return !messages.empty() || closed; });
+          if (messages.empty()) return Response<Message>(ErrorCode::READ_FAILED, "Error: Channel closed by the other side");
+
+          Message message = std::move(messages.front());
+          messages.pop_front();
+          return Response<Message>(std::move(message));
+        }
+
+        void close() {
+          {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+          }
+          ready.notify_all();
+        }
+    };
+
+    struct ThreadChannel {
+      Mailbox toWorker;
+      Mailbox toCoordinator;
+    };
+
+    class ThreadEndpoint : public Endpoint {
+      private:
+        ThreadChannel *channel;
+
+      public:
+        explicit ThreadEndpoint(ThreadChannel *channel) : channel(channel) {}
+
+        Response<void> send(Message message) override {
+          channel->toCoordinator.push(std::move(message));
+          return Response<void>();
+        }
+
+        Response<Message> receive() override {
+          return channel->toWorker.pop();
+        }
+    };
+
+    class ThreadTransport : public Transport {
+      private:
+        std::vector<std::unique_ptr<ThreadChannel>> channels;
+        std::vector<std::thread> threads;
+        std::vector<Response<void>> results;
+        std::atomic<size_t> sent{0};
+        std::atomic<size_t> received{0};
+
+      public:
+        ~ThreadTransport() override { finish(); }
+
+        Kind kind() const override { return Kind::THREADS; }
+
+        Response<void> start(unsigned workers, WorkerMain body) override {
+          if (!channels.empty()) return Response<void>(ErrorCode::INVALID_ARGUMENT, "Error: Transport already started");
+
+          results.resize(workers);
+          for (unsigned i = 0; i < workers; i++) channels.push_back(std::make_unique<ThreadChannel>());
+          for (unsigned i = 0; i < workers; i++) {
+            threads.emplace_back([this, i, body]() {
+              ThreadEndpoint endpoint(channels[i].get());
+              results[i] = body(i, endpoint);
+              channels[i]->toCoordinator.close();  // A receive() on a finished worker fails instead of blocking
+            });
+          }
+          return Response<void>();
+        }
+
+        Response<void> send(unsigned worker, Message message) override {
+          if (worker >= channels.size()) return Response<void>(ErrorCode::INVALID_ARGUMENT, "Error: Unknown worker");
+          sent.fetch_add(message.size(), std::memory_order_relaxed);
+          channels[worker]->toWorker.push(std::move(message));
+          return Response<void>();
+        }
+
+        Response<Message> receive(unsigned worker) override {
+          if (worker >= channels.size()) return Response<Message>(ErrorCode::INVALID_ARGUMENT, "Error: Unknown worker");
+          Response<Message> res = channels[worker]->toCoordinator.pop();
+          if (res.isOk()) received.fetch_add(res.value.size(), std::memory_order_relaxed);
+          return res;
+        }
+
+        Response<void> finish() override {
+          for (auto& channel : channels) channel->toWorker.close();
+          for (std::thread& thread : threads) thread.join();
+          threads.clear();
+
+          for (size_t i = 0; i < results.size(); i++) {
+            if (!results[i].isOk()) {
+              return Response<void>(results[i].code, "Error: Worker " + std::to_string(i) + " failed: " + results[i].describe());
+            }
+          }
+          return Response<void>();
+        }
+
+        size_t bytesSent() const override { return sent.load(std::memory_order_relaxed); }
+        size_t bytesReceived() const override { return received.load(std::memory_order_relaxed); }
+    };
+
+
+    //---- PROCESSES ----//
+
+    bool __sendFull(int fd, const void *data, size_t size) {
+      const char *bytes = static_cast<const char*>(data);
+      while (size > 0) {
+        // MSG_NOSIGNAL: a peer that is gone fails the call instead of raising SIGPIPE
+        ssize_t written = ::send(fd, bytes, size, MSG_NOSIGNAL);
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) return false;
+        bytes += written;
+        size -= static_cast<size_t>(written);
+      }
+      return true;
+    }
+
+    bool __readFull(int fd, void *data, size_t size) {
+      char *bytes = static_cast<char*>(data);
+      while (size > 0) {
+        ssize_t received = ::read(fd, bytes, size);
+        if (received < 0 && errno == EINTR) continue;
+        if (received <= 0) return false;
+        bytes += received;
+        size -= static_cast<size_t>(received);
+      }
+      return true;
+    }
+
+    /// @brief Frame: uint64 length, then the message bytes
+    Response<void> __sendFrame(int fd, const Message& message) {
+      uint64_t length = message.size();
+      if (!__sendFull(fd, &length, sizeof(length)) || !__sendFull(fd, message.data(), message.size())) {
+        return Response<void>(ErrorCode::WRITE_FAILED, "Error: Could not send message to the peer process");
+      }
+      return Response<void>();
+    }
+
+    Response<Message> __receiveFrame(int fd) {
+      uint64_t length;
+      if (!__readFull(fd, &length, sizeof(length))) return Response<Message>(ErrorCode::READ_FAILED, "Error: Peer process closed the channel");
+      if (length > MAX_FRAME) return Response<Message>(ErrorCode::SIZE_LIMIT, "Error: Message frame too large");
+
+      Message message(length);
+      if (!__readFull(fd, message.data(), length)) return Response<Message>(ErrorCode::READ_FAILED, "Error: Peer process closed the channel");
+      return Response<Message>(std::move(message));
+    }
+
+    class SocketEndpoint : public Endpoint {
+      private:
+        int fd;
+
+      public:
+        explicit SocketEndpoint(int fd) : fd(fd) {}
+
+        Response<void> send(Message message) override { return __sendFrame(fd, message); }
+        Response<Message> receive() override { return __receiveFrame(fd); }
+    };
+
+    class ProcessTransport : public Transport {
+      private:
+        std::vector<int> sockets;
+        std::vector<pid_t> children;
+        size_t sent = 0;
+        size_t received = 0;
+
+      public:
+        ~ProcessTransport() override { finish(); }
+
+        Kind kind() const override { return Kind::PROCESSES; }
+
+        Response<void> start(unsigned workers, WorkerMain body) override {
+          if (!sockets.empty()) return Response<void>(ErrorCode::INVALID_ARGUMENT, "Error: Transport already started");
+
+          for (unsigned i = 0; i < workers; i++) {
+            int fds[2];
+            if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0) {
+              finish();
+              return Response<void>(ErrorCode::OPEN_FAILED, "Error: Could not create a worker socket");
+            }
+
+            pid_t pid = ::fork();
+            if (pid < 0) {
+              ::close(fds[0]);
+              ::close(fds[1]);
+              finish();
+              return Response<void>(ErrorCode::OPEN_FAILED, "Error: Could not start a worker process");
+            }
+
+            if (pid == 0) {
+              // Only its own end of its own channel stays open
+              for (int fd : sockets) ::close(fd);
+              ::close(fds[0]);
+
+              SocketEndpoint endpoint(fds[1]);
+              Response<void> res = body(i, endpoint);
+              ::close(fds[1]);
+              ::_exit(res.isOk() ? 0 : 1);  // Skips atexit handlers and stdio buffers of the parent
+            }
+
+            ::close(fds[1]);
+            sockets.push_back(fds[0]);
+            children.push_back(pid);
+          }
+          return Response<void>();
+        }
+
+        Response<void> send(unsigned worker, Message message) override {
+          if (worker >= sockets.size()) return Response<void>(ErrorCode::INVALID_ARGUMENT, "Error: Unknown worker");
+          sent += message.size();
+          return __sendFrame(sockets[worker], message);
+        }
+
+        Response<Message> receive(unsigned worker) override {
+          if (worker >= sockets.size()) return Response<Message>(ErrorCode::INVALID_ARGUMENT, "Error: Unknown worker");
+          Response<Message> res = __receiveFrame(sockets[worker]);
+          if (res.isOk()) received += res.value.size();
+          return res;
+        }
+
+        Response<void> finish() override {
+          // Closing first lets workers still waiting for a message fail and exit
+          for (int fd : sockets) ::close(fd);
+          sockets.clear();
+
+          Response<void> res;
+          for (size_t i = 0; i < children.size(); i++) {
+            int status = 0;
+            while (::waitpid(children[i], &status, 0) < 0 && errno == EINTR) {}
+            if (res.isOk() && !(WIFEXITED(status) && WEXITSTATUS(status) == 0)) {
+              res = Response<void>(ErrorCode::READ_FAILED, "Error: Worker process " + std::to_string(i) + " failed");
+            }
+          }
+          children.clear();
+          return res;
+        }
+
+        size_t bytesSent() const override { return sent; }
+        size_t bytesReceived() const override { return received; }
+    };
+  }
+
+
+  //---- Métodos públicos ----//
+
+  const char* kindToString(Kind kind) {
+    switch (kind) {
+      case Kind::THREADS: return "threads";
+      case Kind::PROCESSES: return "processes";
+    }
+    return "unknown";
+  }
+
+  std::unique_ptr<Transport> makeTransport(Kind kind) {
+    if (kind == Kind::PROCESSES) return std::make_unique<ProcessTransport>();
+    return std::make_unique<ThreadTransport>();
+  }
+}
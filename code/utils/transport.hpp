@@ -0,0 +1,118 @@
+#ifndef TRANSPORT_HPP
+#define TRANSPORT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "response_struct.hpp"
+
+
+/**
+ * @brief Message passing between a coordinator and a set of workers
+ *
+ * A stand-in for a cluster interconnect: the coordinator starts the workers, then trades
+ * whole messages (byte buffers) with each of them over a private, ordered channel. Code
+ * written against Transport does not know whether the workers are threads or processes.
+ *
+ * - THREADS: workers are threads of this process, messages are moved through mailboxes
+ * - PROCESSES: every worker is a forked process connected by a socketpair, messages are
+ *   length-prefixed frames. Workers only see what they receive, like remote nodes
+ *
+ * Worker functions of the PROCESSES transport run on a forked copy of a possibly threaded
+ * process, so they must not use the shared scheduler (its threads do not exist there).
+ */
+namespace transport {
+
+    using Message = std::vector<char>;
+
+    enum class Kind {
+        THREADS,
+        PROCESSES
+    };
+
+    const char* kindToString(Kind kind);
+
+    /// @brief Worker side of a channel, talks to the coordinator only
+    class Endpoint {
+      public:
+        virtual ~Endpoint() = default;
+
+        virtual Response<void> send(Message message) = 0;
+        virtual Response<Message> receive() = 0;
+    };
+
+    /// @brief Body of a worker, `rank` on range [0 ... workers-1]
+    using WorkerMain = std::function<Response<void>(unsigned rank, Endpoint& coordinator)>;
+
+    /// @brief Coordinator side
+    class Transport {
+      public:
+        virtual ~Transport() = default;
+
+        virtual Kind kind() const = 0;
+
+        /// @brief Starts `workers` workers running `body`, only once per transport
+        virtual Response<void> start(unsigned workers, WorkerMain body) = 0;
+
+        virtual Response<void> send(unsigned worker, Message message) = 0;
+
+        /// @brief Next message from `worker`, blocks until it arrives
+        virtual Response<Message> receive(unsigned worker) = 0;
+
+        /// @brief Waits for every worker to return. Fails when any of them failed
+        virtual Response<void> finish() = 0;
+
+        /// @brief Bytes sent to and received from the workers so far
+        virtual size_t bytesSent() const = 0;
+        virtual size_t bytesReceived() const = 0;
+    };
+
+    std::unique_ptr<Transport> makeTransport(Kind kind);
+
+
+    //---- Serialização ----//
+
+    /// @brief Appends the raw bytes of trivially copyable values
+    template <typename T>
+    void append(Message& message, const T *values, size_t count) {
+        const char *bytes = reinterpret_cast<const char*>(values);
+        message.insert(message.end(), bytes, bytes + count * sizeof(T));
+    }
+
+    template <typename T>
+    void append(Message& message, const T& value) {
+        append(message, &value, 1);
+    }
+
+    /// @brief Reads values back in the order they were appended
+    class Reader {
+      private:
+        const Message *message;
+        size_t position = 0;
+
+      public:
+        explicit Reader(const Message& message) : message(&message) {}
+
+        /// @brief False (reading nothing) when fewer than count values are left
+        template <typename T>
+        bool read(T *values, size_t count) {
+            size_t bytes = count * sizeof(T);
+            if (bytes > message->size() - position) return false;
+            std::copy(message->data() + position, message->data() + position + bytes, reinterpret_cast<char*>(values));
+            position += bytes;
+            return true;
+        }
+
+        template <typename T>
+        bool read(T& value) {
+            return read(&value, 1);
+        }
+
+        bool done() const { return position == message->size(); }
+    };
+}
+
+
+#endif  // TRANSPORT_HPP
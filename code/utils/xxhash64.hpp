@@ -0,0 +1,141 @@
+#ifndef XXHASH64_HPP
+#define XXHASH64_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+
+namespace hashing {
+
+    /**
+     * @brief Streaming XXH64, same digest as the reference xxHash implementation
+     *
+     * Consumes 32 bytes per step on 4 independent lanes, several GB/s on a single core,
+     * which keeps content hashing of graph files far below their read time.
+     * Inputs are read as little-endian 64/32-bit words.
+     */
+    class Xxh64 {
+      private:
+        static constexpr uint64_t P1 = 11400714785074694791ULL;
+        static constexpr uint64_t P2 = 14029467366897019727ULL;
+        static constexpr uint64_t P3 = 1609587929392839161ULL;
+        static constexpr uint64_t P4 = 9650029242287828579ULL;
+        static constexpr uint64_t P5 = 2870177450012600261ULL;
+
+        uint64_t seed;
+        uint64_t lane[4];
+        uint64_t totalLength = 0;
+        unsigned char pending[32];
+        size_t pendingSize = 0;
+
+        static uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+        static uint64_t read64(const unsigned char *p) { uint64_t v; std::memcpy(&v, p, 8); return v; }
+        static uint32_t read32(const unsigned char *p) { uint32_t v; std::memcpy(&v, p, 4); return v; }
+
+        static uint64_t round(uint64_t acc, uint64_t input) {
+            acc += input * P2;
+            acc = rotl(acc, 31);
+            return acc * P1;
+        }
+
+        static uint64_t mergeRound(uint64_t acc, uint64_t value) {
+            acc ^= round(0, value);
+            return acc * P1 + P4;
+        }
+
+        void consumeStripe(const unsigned char *p) {
+            lane[0] = round(lane[0], read64(p));
+            lane[1] = round(lane[1], read64(p + 8));
+            lane[2] = round(lane[2], read64(p + 16));
+            lane[3] = round(lane[3], read64(p + 24));
+        }
+
+      public:
+        explicit Xxh64(uint64_t seed = 0) : seed(seed) {
+            lane[0] = seed + P1 + P2;
+            lane[1] = seed + P2;
+            lane[2] = seed;
+            lane[3] = seed - P1;
+        }
+
+        void update(const void *data, size_t length) {
+            const unsigned char *p = static_cast<const unsigned char*>(data);
+            totalLength += length;
+
+            if (pendingSize + length < 32) {
+                std::memcpy(pending + pendingSize, p, length);
+                pendingSize += length;
+                return;
+            }
+
+            if (pendingSize > 0) {
+                size_t fill = 32 - pendingSize;
+                std::memcpy(pending + pendingSize, p, fill);
+                consumeStripe(pending);
+                p += fill;
+                length -= fill;
+                pendingSize = 0;
+            }
+
+            while (length >= 32) {
+                consumeStripe(p);
+                p += 32;
+                length -= 32;
+            }
+
+            std::memcpy(pending, p, length);
+            pendingSize = length;
+        }
+
+        uint64_t digest() const {
+            uint64_t h;
+            if (totalLength >= 32) {
+                h = rotl(lane[0], 1) + rotl(lane[1], 7) + rotl(lane[2], 12) + rotl(lane[3], 18);
+                for (uint64_t value : lane) h = mergeRound(h, value);
+            } else {
+                h = seed + P5;
+            }
+            h += totalLength;
+
+            const unsigned char *p = pending;
+            size_t left = pendingSize;
+            while (left >= 8) {
+                h ^= round(0, read64(p));
+                h = rotl(h, 27) * P1 + P4;
+                p += 8;
+                left -= 8;
+            }
+            if (left >= 4) {
+                h ^= static_cast<uint64_t>(read32(p)) * P1;
+                h = rotl(h, 23) * P2 + P3;
+                p += 4;
+                left -= 4;
+            }
+            while (left > 0) {
+                h ^= (*p) * P5;
+                h = rotl(h, 11) * P1;
+                p++;
+                left--;
+            }
+
+            h ^= h >> 33;
+            h *= P2;
+            h ^= h >> 29;
+            h *= P3;
+            h ^= h >> 32;
+            return h;
+        }
+    };
+
+    /// @brief One-shot XXH64 of a buffer
+    inline uint64_t xxh64(const void *data, size_t length, uint64_t seed = 0) {
+        Xxh64 state(seed);
+        state.update(data, length);
+        return state.digest();
+    }
+}
+
+
+#endif  // XXHASH64_HPP